@@ -19,7 +19,7 @@ try
   actors_ = actors;
   api_ptr_ = api_ptr;
 
-  if (actors_.empty())
+  if (actors_.empty() and not actors_selected_)
   {
     SCENARIO_WARNING_ABOUT_NO_ACTORS_SPECIFIED();
   }
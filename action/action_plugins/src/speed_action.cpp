@@ -17,7 +17,7 @@ try
   actors_ = actors;
   api_ptr_ = simulator;
 
-  if (actors_.empty())
+  if (actors_.empty() and not actors_selected_)
   {
     SCENARIO_WARNING_ABOUT_NO_ACTORS_SPECIFIED();
   }
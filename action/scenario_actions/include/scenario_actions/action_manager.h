@@ -9,8 +9,10 @@
 #include <yaml-cpp/yaml.h>
 
 #include <scenario_actions/entity_action_base.h>
+#include <scenario_actions/timer_wheel.h>
 #include <scenario_api/scenario_api_core.h>
 #include <scenario_intersection/intersection_manager.h>
+#include <scenario_logger/dispatch_latency.h>
 
 namespace scenario_actions
 {
@@ -21,19 +23,44 @@ public:
   ActionManager(
     const YAML::Node& node,
     const std::vector<std::string>& actors,
-    const std::shared_ptr<ScenarioAPI>& api_ptr);
+    const std::shared_ptr<ScenarioAPI>& api_ptr,
+    const std::shared_ptr<TimerWheel>& timer_wheel = nullptr,
+    bool actors_selected = false);  // NOTE: True if actor selectors give the actors when run.
 
+  // NOTE: Cancels the periodic actions; they run as long as their owner (e.g. the sequence).
+  ~ActionManager();
+
+  ActionManager(const ActionManager&) = delete;
+  ActionManager& operator=(const ActionManager&) = delete;
+
+  // NOTE: Measures the actions run right away into `firing`, if given.
   auto run(
-    const std::shared_ptr<scenario_intersection::IntersectionManager>&)
+    const std::shared_ptr<scenario_intersection::IntersectionManager>&,
+    scenario_logger::DispatchLatency::Firing* firing = nullptr)
     -> void;
 
+  void setActors(const std::vector<std::string>& actors);
+
 private:
   const YAML::Node actions_node_;
   const std::vector<std::string> actors_;
 
+  const bool actors_selected_;
+
   const std::shared_ptr<ScenarioAPI> api_ptr_;
 
-  std::vector<boost::shared_ptr<EntityActionBase>> actions_;
+  const std::shared_ptr<TimerWheel> timer_wheel_;
+
+  struct Scheduled
+  {
+    boost::shared_ptr<EntityActionBase> action;
+
+    double delay, period;  // [sec], run immediately and once if both are zero
+  };
+
+  std::vector<Scheduled> actions_;
+
+  std::vector<TimerWheel::Handle> periodic_;  // NOTE: Pending until cancelled.
 
   bool loadPlugin(const YAML::Node& node);
 };
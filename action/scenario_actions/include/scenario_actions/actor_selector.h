@@ -0,0 +1,56 @@
+#ifndef SCENARIO_ACTIONS_ACTOR_SELECTOR_H_INCLUDED
+#define SCENARIO_ACTIONS_ACTOR_SELECTOR_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+#include <scenario_actions/entity_index.h>
+#include <scenario_api/scenario_api_core.h>
+
+namespace scenario_actions
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * ACTOR SELECTOR
+ *
+ * An entry of Actors given as a map instead of a name. Selects the entities
+ * that satisfy all of the given clauses at the time the event fires.
+ *
+ *   Actors:
+ *     - npc1                            # by name, as before
+ *     - Type: Car                       # by type (Ego, Car, Pedestrian, ...)
+ *       Radius: { Entity: ego, Value: 30 }  # within 30 m of ego, except ego
+ *     - Region: [ { X: 0, Y: 0 }, { X: 10, Y: 0 }, { X: 10, Y: 10 } ]
+ *     - Lanelet: [ 34468, 34507 ]
+ *
+ * -------------------------------------------------------------------------- */
+class ActorSelector
+{
+public:
+  explicit ActorSelector(const YAML::Node&);
+
+  /* NOTE: Appends the names of the selected entities that are not in result
+   * yet. */
+  void select(const EntityIndex&, ScenarioAPI&, std::vector<std::string>& result) const;
+
+private:
+  bool matches(const EntityIndex::Entry&, const EntityIndex::Entry* center, ScenarioAPI&) const;
+
+  boost::optional<std::string> type_;
+
+  boost::optional<std::string> radius_entity_;
+  double radius_;
+
+  boost::optional<Polygon> region_;
+
+  std::vector<int> lanelets_;
+};
+
+}  // namespace scenario_actions
+
+#endif  // SCENARIO_ACTIONS_ACTOR_SELECTOR_H_INCLUDED
@@ -28,6 +28,22 @@ public:
     api_ptr_ = api_ptr;
   }
 
+  /* NOTE: Replaces the actors given to configure, e.g. with those chosen by
+   * actor selectors when the event fires. */
+  void setActors(const std::vector<std::string> & actors)
+  {
+    actors_ = actors;
+  }
+
+  /* NOTE: Set before configure if actor selectors will give the actors, so
+   * that no actors given to configure is not warned about. */
+  void setActorsSelected(bool selected) noexcept
+  {
+    actors_selected_ = selected;
+  }
+
+  const std::string & getType() const noexcept { return type_; }
+
   EntityActionBase() = default;
 
   EntityActionBase(const std::string & type)
@@ -42,6 +58,8 @@ protected:
 
   std::vector<std::string> actors_;
 
+  bool actors_selected_ = false;
+
   std::shared_ptr<ScenarioAPI> api_ptr_;
 };
 
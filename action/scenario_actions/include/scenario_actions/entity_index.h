@@ -0,0 +1,89 @@
+#ifndef SCENARIO_ACTIONS_ENTITY_INDEX_H_INCLUDED
+#define SCENARIO_ACTIONS_ENTITY_INDEX_H_INCLUDED
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <scenario_api/scenario_api_entity_state.h>
+
+namespace scenario_actions
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * ENTITY INDEX
+ *
+ * Spatial hash over the entity snapshot, rebuilt by the runner once per tick,
+ * so that actor selectors find the entities near a point or inside a region
+ * by visiting a few grid cells instead of every entity.
+ *
+ * -------------------------------------------------------------------------- */
+class EntityIndex
+{
+public:
+  struct Entry
+  {
+    std::string name, type;
+
+    double x, y;  // position in map frame
+  };
+
+  explicit EntityIndex(double cell_size = 10.0);  // [m]
+
+  void build(const std::vector<EntityState>&);
+
+  const std::vector<Entry>& entries() const noexcept
+  {
+    return entries_;
+  }
+
+  const Entry* find(const std::string& name) const;
+
+  /* NOTE: Visits the index of every entry in the cells overlapping the box,
+   * i.e. a superset of the entries inside it. */
+  template <typename F>
+  void query(double min_x, double min_y, double max_x, double max_y, F&& visit) const
+  {
+    for (auto x { cell(min_x) }; x <= cell(max_x); ++x)
+    {
+      for (auto y { cell(min_y) }; y <= cell(max_y); ++y)
+      {
+        const auto iter { cells_.find(key(x, y)) };
+
+        if (iter != cells_.end())
+        {
+          for (const auto& each : iter->second)
+          {
+            visit(each);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  std::int32_t cell(double coordinate) const
+  {
+    return static_cast<std::int32_t>(std::floor(coordinate / cell_size_));
+  }
+
+  static std::uint64_t key(std::int32_t x, std::int32_t y)
+  {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+  }
+
+  const double cell_size_;
+
+  std::vector<Entry> entries_;
+
+  std::unordered_map<std::string, std::size_t> names_;
+
+  std::unordered_map<std::uint64_t, std::vector<std::size_t>> cells_;
+};
+
+}  // namespace scenario_actions
+
+#endif  // SCENARIO_ACTIONS_ENTITY_INDEX_H_INCLUDED
@@ -0,0 +1,79 @@
+#ifndef SCENARIO_ACTIONS_TIMER_WHEEL_H_INCLUDED
+#define SCENARIO_ACTIONS_TIMER_WHEEL_H_INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+namespace scenario_actions
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * TIMER WHEEL
+ *
+ * Hierarchical timing wheel (Varghese & Lauck) for delayed and periodic
+ * actions. Time is quantized to ticks of the given resolution; level n has 64
+ * slots of 64^n ticks each, and a timer is cascaded to the level below when
+ * its slot comes round. Scheduling, cancelling and advancing by one tick are
+ * O(1), so pending timers cost nothing until they are due.
+ *
+ * Callbacks run inside advance(), in the runner's tick, and may schedule
+ * further timers. A timer is never due in the tick it is scheduled in.
+ *
+ * -------------------------------------------------------------------------- */
+class TimerWheel
+{
+public:
+  using Callback = std::function<void()>;
+
+  using Handle = std::uint64_t;
+
+  explicit TimerWheel(double resolution = 0.01);  // [sec]
+
+  /* NOTE: Fires after delay [sec], then every period [sec] if period is
+   * positive, until cancelled. */
+  Handle schedule(double delay, const Callback& callback, double period = 0);
+
+  bool cancel(Handle);
+
+  void advance(double now);  // [sec], monotonic; earlier times are ignored
+
+  std::size_t size() const noexcept
+  {
+    return active_.size();
+  }
+
+private:
+  static constexpr int bits { 6 };
+  static constexpr int slots { 1 << bits };
+  static constexpr int levels { 4 };
+
+  struct Timer
+  {
+    Handle handle;
+    std::uint64_t expires;  // [tick]
+    std::uint64_t period;   // [tick], 0 if one-shot
+    Callback callback;
+  };
+
+  void insert(Timer&&);
+
+  std::uint64_t ticks(double duration) const;
+
+  const double resolution_;
+
+  std::uint64_t current_;  // [tick]
+
+  Handle next_handle_;
+
+  std::array<std::array<std::vector<Timer>, slots>, levels> wheels_;
+
+  std::unordered_set<Handle> active_;
+};
+
+}  // namespace scenario_actions
+
+#endif  // SCENARIO_ACTIONS_TIMER_WHEEL_H_INCLUDED
@@ -6,11 +6,15 @@ namespace scenario_actions
 ActionManager::ActionManager(
   const YAML::Node& actions_node,
   const std::vector<std::string>& actors,
-  const std::shared_ptr<ScenarioAPI>& api_ptr)
+  const std::shared_ptr<ScenarioAPI>& api_ptr,
+  const std::shared_ptr<TimerWheel>& timer_wheel,
+  bool actors_selected)
 try
   : actions_node_ {actions_node}
   , actors_ {actors}
+  , actors_selected_ {actors_selected}
   , api_ptr_ {api_ptr}
+  , timer_wheel_ {timer_wheel}
 {
   for (const auto& action_node : actions_node_)
   {
@@ -22,12 +26,23 @@ catch (...)
   SCENARIO_ERROR_RETHROW(CATEGORY(), "Failed to initialize actions.");
 }
 
+ActionManager::~ActionManager()
+{
+  for (const auto& each : periodic_)
+  {
+    timer_wheel_->cancel(each);
+  }
+}
+
 bool ActionManager::loadPlugin(const YAML::Node& node)
 try
 {
   const auto type { read_essential<std::string>(node, "Type") + "Action" };
 
-  pluginlib::ClassLoader<scenario_actions::EntityActionBase> loader("scenario_actions", "scenario_actions::EntityActionBase");
+  // NOTE: Reading the plugin manifests is expensive, so they are read once per process.
+  static pluginlib::ClassLoader<scenario_actions::EntityActionBase> loader {
+    "scenario_actions", "scenario_actions::EntityActionBase"
+  };
 
   const std::vector<std::string> classes = loader.getDeclaredClasses();
 
@@ -45,8 +60,26 @@ try
   else
   {
     auto plugin = loader.createInstance(*iter);
+    plugin->setActorsSelected(actors_selected_);
     plugin->configure(node, actors_, api_ptr_);
-    actions_.push_back(plugin);
+
+    // NOTE: Not read_optional, which would warn about every action without them.
+    const auto delay { node["Delay"] ? node["Delay"].as<double>() : 0.0 };
+    const auto period { node["Period"] ? node["Period"].as<double>() : 0.0 };
+
+    if (delay < 0 or period < 0)
+    {
+      SCENARIO_ERROR_THROW(CATEGORY(), "Delay and Period of " << type << " must not be negative.");
+    }
+    else if ((0 < delay or 0 < period) and not timer_wheel_)
+    {
+      SCENARIO_WARN_STREAM(CATEGORY(), "Delay and Period of " << type << " are ignored here (no timer wheel).");
+      actions_.push_back({ plugin, 0, 0 });
+    }
+    else
+    {
+      actions_.push_back({ plugin, delay, period });
+    }
   }
 }
 catch (...)
@@ -54,13 +87,62 @@ catch (...)
   SCENARIO_ERROR_RETHROW(CATEGORY(), "Failed to load action plugin.");
 }
 
+void ActionManager::setActors(const std::vector<std::string>& actors)
+{
+  for (const auto& each : actions_)
+  {
+    each.action->setActors(actors);
+  }
+}
+
 void ActionManager::run(
-  const std::shared_ptr<scenario_intersection::IntersectionManager>& intersection_manager)
+  const std::shared_ptr<scenario_intersection::IntersectionManager>& intersection_manager,
+  scenario_logger::DispatchLatency::Firing* firing)
 try
 {
   for (const auto& each : actions_)
   {
-    each->run(intersection_manager);
+    if (each.delay <= 0 and each.period <= 0)
+    {
+      const auto begin { scenario_logger::DispatchLatency::Clock::now() };
+
+      each.action->run(intersection_manager);
+
+      if (firing)
+      {
+        firing->dispatched(each.action->getType(), begin);
+      }
+    }
+    else
+    {
+      // NOTE: Captured by value; one-shot timers may outlive this manager (e.g. a finished sequence).
+      const auto run = [action = each.action, intersection_manager]()
+      {
+        action->run(intersection_manager);
+      };
+
+      if (each.delay <= 0)
+      {
+        const auto begin { scenario_logger::DispatchLatency::Clock::now() };
+
+        run();
+
+        if (firing)
+        {
+          firing->dispatched(each.action->getType(), begin);
+        }
+
+        periodic_.push_back(timer_wheel_->schedule(each.period, run, each.period));
+      }
+      else if (each.period <= 0)
+      {
+        timer_wheel_->schedule(each.delay, run);
+      }
+      else
+      {
+        periodic_.push_back(timer_wheel_->schedule(each.delay, run, each.period));
+      }
+    }
   }
 }
 catch (...)
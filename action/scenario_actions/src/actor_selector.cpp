@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cmath>
+
+#include <boost/algorithm/string.hpp>
+
+#include <scenario_actions/actor_selector.h>
+#include <scenario_utility/scenario_utility.h>
+
+namespace scenario_actions
+{
+
+ActorSelector::ActorSelector(const YAML::Node& node)
+try
+  : radius_ {0}
+{
+  // NOTE: Not call_with_optional, which warns about every clause left out.
+  if (const auto type { node["Type"] })
+  {
+    // NOTE: Same spelling as the entity definitions, where Vehicle means car.
+    type_ = boost::iequals(type.as<std::string>(), "Vehicle") ? "car" : type.as<std::string>();
+  }
+
+  if (const auto radius { node["Radius"] })
+  {
+    radius_entity_ = read_essential<std::string>(radius, "Entity");
+    radius_ = read_essential<double>(radius, "Value");
+  }
+
+  if (const auto vertices { node["Region"] })
+  {
+    Polygon region {};
+
+    for (const auto& each : vertices)
+    {
+      region.outer().emplace_back(read_essential<double>(each, "X"), read_essential<double>(each, "Y"));
+    }
+
+    if (region.outer().size() < 3)
+    {
+      SCENARIO_ERROR_THROW(CATEGORY(), "Region requires three or more vertices.");
+    }
+
+    bg::correct(region);
+
+    region_ = region;
+  }
+
+  if (const auto lanelets { node["Lanelet"] })
+  {
+    if (lanelets.IsSequence())
+    {
+      lanelets_ = lanelets.as<std::vector<int>>();
+    }
+    else
+    {
+      lanelets_.push_back(lanelets.as<int>());
+    }
+  }
+
+  if (not type_ and not radius_entity_ and not region_ and lanelets_.empty())
+  {
+    SCENARIO_ERROR_THROW(CATEGORY(), "Actor selector requires one or more of Type, Radius, Region and Lanelet.");
+  }
+}
+catch (...)
+{
+  SCENARIO_ERROR_RETHROW(CATEGORY(), "Syntax error: malformed actor selector.\n\n" << node << "\n");
+}
+
+bool ActorSelector::matches(
+  const EntityIndex::Entry& entry, const EntityIndex::Entry* center, ScenarioAPI& api) const
+{
+  if (type_ and not boost::iequals(entry.type, *type_))
+  {
+    return false;
+  }
+
+  if (center and (&entry == center or radius_ < std::hypot(entry.x - center->x, entry.y - center->y)))
+  {
+    return false;
+  }
+
+  if (region_ and not bg::covered_by(Point(entry.x, entry.y), *region_))
+  {
+    return false;
+  }
+
+  if (not lanelets_.empty())
+  {
+    int lanelet {};
+
+    return api.getEntityLaneID(entry.name, lanelet) and
+           std::find(lanelets_.begin(), lanelets_.end(), lanelet) != lanelets_.end();
+  }
+
+  return true;
+}
+
+void ActorSelector::select(
+  const EntityIndex& index, ScenarioAPI& api, std::vector<std::string>& result) const
+{
+  const auto append = [&](const EntityIndex::Entry& entry)
+  {
+    if (std::find(result.begin(), result.end(), entry.name) == result.end())
+    {
+      result.push_back(entry.name);
+    }
+  };
+
+  const EntityIndex::Entry* center { nullptr };
+
+  if (radius_entity_)
+  {
+    // NOTE: Selects nothing while the reference entity does not exist.
+    if (not (center = index.find(*radius_entity_)))
+    {
+      return;
+    }
+
+    index.query(center->x - radius_, center->y - radius_, center->x + radius_, center->y + radius_,
+      [&](std::size_t i)
+      {
+        if (matches(index.entries()[i], center, api))
+        {
+          append(index.entries()[i]);
+        }
+      });
+  }
+  else if (region_)
+  {
+    bg::model::box<Point> box {};
+    bg::envelope(*region_, box);
+
+    index.query(box.min_corner().x(), box.min_corner().y(), box.max_corner().x(), box.max_corner().y(),
+      [&](std::size_t i)
+      {
+        if (matches(index.entries()[i], center, api))
+        {
+          append(index.entries()[i]);
+        }
+      });
+  }
+  else
+  {
+    for (const auto& each : index.entries())
+    {
+      if (matches(each, center, api))
+      {
+        append(each);
+      }
+    }
+  }
+}
+
+}  // namespace scenario_actions
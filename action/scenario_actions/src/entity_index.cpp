@@ -0,0 +1,32 @@
+#include <scenario_actions/entity_index.h>
+
+namespace scenario_actions
+{
+
+EntityIndex::EntityIndex(double cell_size)
+  : cell_size_ {cell_size}
+{}
+
+void EntityIndex::build(const std::vector<EntityState>& entities)
+{
+  entries_.clear();
+  names_.clear();
+  cells_.clear();
+
+  for (const auto& each : entities)
+  {
+    names_.emplace(each.name, entries_.size());
+
+    cells_[key(cell(each.pose.position.x), cell(each.pose.position.y))].push_back(entries_.size());
+
+    entries_.push_back({ each.name, each.type, each.pose.position.x, each.pose.position.y });
+  }
+}
+
+const EntityIndex::Entry* EntityIndex::find(const std::string& name) const
+{
+  const auto iter { names_.find(name) };
+  return iter != names_.end() ? &entries_[iter->second] : nullptr;
+}
+
+}  // namespace scenario_actions
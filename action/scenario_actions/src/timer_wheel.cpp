@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cmath>
+
+#include <scenario_actions/timer_wheel.h>
+
+namespace scenario_actions
+{
+
+constexpr int TimerWheel::bits;
+constexpr int TimerWheel::slots;
+constexpr int TimerWheel::levels;
+
+TimerWheel::TimerWheel(double resolution)
+  : resolution_ {resolution}
+  , current_ {0}
+  , next_handle_ {1}
+{}
+
+std::uint64_t TimerWheel::ticks(double duration) const
+{
+  // NOTE: At least one tick, so that nothing is due in the tick it is scheduled in.
+  return std::max<std::uint64_t>(1, std::ceil(duration / resolution_ - 1e-9));
+}
+
+TimerWheel::Handle TimerWheel::schedule(double delay, const Callback& callback, double period)
+{
+  const auto handle { next_handle_++ };
+
+  insert({ handle, current_ + ticks(delay), 0 < period ? ticks(period) : 0, callback });
+
+  active_.insert(handle);
+
+  return handle;
+}
+
+bool TimerWheel::cancel(Handle handle)
+{
+  // NOTE: The timer itself is dropped lazily, when its slot comes round.
+  return active_.erase(handle);
+}
+
+void TimerWheel::insert(Timer&& timer)
+{
+  const auto delta { timer.expires - current_ };
+
+  for (int level {0}; level < levels; ++level)
+  {
+    if (delta < (std::uint64_t(1) << (bits * (level + 1))))
+    {
+      wheels_[level][(timer.expires >> (bits * level)) & (slots - 1)].push_back(std::move(timer));
+      return;
+    }
+  }
+
+  // NOTE: Beyond the range of the wheel; parked in the farthest slot and re-inserted from there.
+  wheels_[levels - 1][((current_ >> (bits * (levels - 1))) - 1) & (slots - 1)].push_back(std::move(timer));
+}
+
+void TimerWheel::advance(double now)
+{
+  const auto target { static_cast<std::uint64_t>(std::max(0.0, std::floor(now / resolution_ + 1e-9))) };
+
+  while (current_ < target)
+  {
+    if (active_.empty())
+    {
+      current_ = target;
+      break;
+    }
+
+    ++current_;
+
+    for (int level {1}; level < levels and (current_ & ((std::uint64_t(1) << (bits * level)) - 1)) == 0; ++level)
+    {
+      auto cascaded { std::move(wheels_[level][(current_ >> (bits * level)) & (slots - 1)]) };
+
+      wheels_[level][(current_ >> (bits * level)) & (slots - 1)].clear();
+
+      for (auto&& each : cascaded)
+      {
+        if (active_.count(each.handle))
+        {
+          insert(std::move(each));
+        }
+      }
+    }
+
+    auto due { std::move(wheels_[0][current_ & (slots - 1)]) };
+
+    wheels_[0][current_ & (slots - 1)].clear();
+
+    for (auto&& each : due)
+    {
+      if (not active_.count(each.handle))
+      {
+        continue;
+      }
+      else if (current_ < each.expires)  // NOTE: Parked beyond the range of the wheel.
+      {
+        insert(std::move(each));
+      }
+      else
+      {
+        if (each.period)
+        {
+          each.expires += each.period;
+          const auto callback { each.callback };
+          insert(std::move(each));
+          callback();
+        }
+        else
+        {
+          active_.erase(each.handle);
+          each.callback();
+        }
+      }
+    }
+  }
+}
+
+}  // namespace scenario_actions
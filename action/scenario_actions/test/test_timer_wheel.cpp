@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <scenario_actions/timer_wheel.h>
+
+using scenario_actions::TimerWheel;
+
+namespace
+{
+
+// NOTE: A resolution of 1 [sec] makes ticks and seconds the same.
+struct Recorder
+{
+  TimerWheel wheel { 1.0 };
+
+  std::uint64_t now { 0 };
+
+  std::map<TimerWheel::Handle, std::vector<std::uint64_t>> fired;
+
+  TimerWheel::Handle schedule(std::uint64_t delay, std::uint64_t period = 0)
+  {
+    auto handle { std::make_shared<TimerWheel::Handle>() };
+    *handle = wheel.schedule(delay, [this, handle]() { fired[*handle].push_back(now); }, period);
+    return *handle;
+  }
+
+  void advance(std::uint64_t until)
+  {
+    while (now < until)
+    {
+      wheel.advance(++now);
+    }
+  }
+};
+
+}  // namespace
+
+TEST(TimerWheel, FiresOnceAfterDelay)
+{
+  Recorder recorder {};
+
+  const auto handle { recorder.schedule(5) };
+
+  recorder.advance(100);
+
+  EXPECT_EQ(recorder.fired[handle], (std::vector<std::uint64_t> {5}));
+  EXPECT_EQ(recorder.wheel.size(), 0u);
+}
+
+TEST(TimerWheel, NeverFiresInTheTickScheduled)
+{
+  Recorder recorder {};
+
+  recorder.advance(10);
+
+  const auto handle { recorder.schedule(0) };
+
+  recorder.wheel.advance(10);
+  EXPECT_TRUE(recorder.fired[handle].empty());
+
+  recorder.advance(11);
+  EXPECT_EQ(recorder.fired[handle], (std::vector<std::uint64_t> {11}));
+}
+
+TEST(TimerWheel, FiresEveryPeriod)
+{
+  Recorder recorder {};
+
+  const auto handle { recorder.schedule(3, 2) };
+
+  recorder.advance(10);
+
+  EXPECT_EQ(recorder.fired[handle], (std::vector<std::uint64_t> {3, 5, 7, 9}));
+  EXPECT_EQ(recorder.wheel.size(), 1u);
+}
+
+TEST(TimerWheel, CatchesUpWhenAdvancedByMoreThanOneTick)
+{
+  Recorder recorder {};
+
+  const auto once { recorder.schedule(3) };
+  const auto periodic { recorder.schedule(1, 1) };
+
+  recorder.now = 5;
+  recorder.wheel.advance(5);
+
+  EXPECT_EQ(recorder.fired[once].size(), 1u);
+  EXPECT_EQ(recorder.fired[periodic].size(), 5u);
+}
+
+TEST(TimerWheel, CancelsPeriodicTimers)
+{
+  Recorder recorder {};
+
+  const auto handle { recorder.schedule(1, 1) };
+
+  recorder.advance(3);
+
+  EXPECT_TRUE(recorder.wheel.cancel(handle));
+  EXPECT_FALSE(recorder.wheel.cancel(handle));
+
+  recorder.advance(200);
+
+  EXPECT_EQ(recorder.fired[handle].size(), 3u);
+  EXPECT_EQ(recorder.wheel.size(), 0u);
+}
+
+TEST(TimerWheel, CancelsFromItsOwnCallback)
+{
+  TimerWheel wheel { 1.0 };
+
+  int count { 0 };
+  TimerWheel::Handle handle {};
+
+  handle = wheel.schedule(1, [&]() { if (++count == 2) { wheel.cancel(handle); } }, 1);
+
+  wheel.advance(100);
+
+  EXPECT_EQ(count, 2);
+}
+
+TEST(TimerWheel, IgnoresEarlierTimes)
+{
+  Recorder recorder {};
+
+  recorder.advance(50);
+
+  const auto handle { recorder.schedule(10) };
+
+  recorder.wheel.advance(20);
+  recorder.advance(59);
+  EXPECT_TRUE(recorder.fired[handle].empty());
+
+  recorder.advance(60);
+  EXPECT_EQ(recorder.fired[handle], (std::vector<std::uint64_t> {60}));
+}
+
+// NOTE: Delays at and around the span of each level, scheduled off the slot boundaries as well.
+TEST(TimerWheel, CascadesAtLevelBoundaries)
+{
+  for (const std::uint64_t start : {0, 1, 63, 64, 65, 4095, 4096, 4097})
+  {
+    for (const std::uint64_t span : {64, 4096, 262144})
+    {
+      for (const std::uint64_t delay : {span - 1, span, span + 1, 2 * span - 1, 2 * span})
+      {
+        Recorder recorder {};
+
+        recorder.advance(start);
+
+        const auto handle { recorder.schedule(delay) };
+
+        recorder.advance(start + delay - 1);
+        ASSERT_TRUE(recorder.fired[handle].empty()) << start << " + " << delay;
+
+        recorder.advance(start + delay);
+        ASSERT_EQ(recorder.fired[handle], (std::vector<std::uint64_t> {start + delay})) << start << " + " << delay;
+      }
+    }
+  }
+}
+
+// NOTE: 64^4 ticks is the span of the wheel; farther timers are parked and re-inserted.
+TEST(TimerWheel, FiresBeyondTheSpanOfTheWheel)
+{
+  constexpr std::uint64_t span { std::uint64_t(1) << 24 };
+
+  for (const std::uint64_t delay : {span - 1, span, span + 1, 2 * span + 12345})
+  {
+    Recorder recorder {};
+
+    recorder.advance(7);
+
+    const auto handle { recorder.schedule(delay) };
+
+    recorder.advance(7 + delay - 1);
+    ASSERT_TRUE(recorder.fired[handle].empty()) << delay;
+
+    recorder.advance(7 + delay);
+    ASSERT_EQ(recorder.fired[handle], (std::vector<std::uint64_t> {7 + delay})) << delay;
+  }
+}
+
+TEST(TimerWheel, MatchesBruteForce)
+{
+  std::mt19937 engine { 42 };
+
+  Recorder recorder {};
+
+  std::map<TimerWheel::Handle, std::vector<std::uint64_t>> expected {};
+
+  constexpr std::uint64_t until { 20000 };
+
+  for (int i {0}; i < 500; ++i)
+  {
+    recorder.advance(std::uniform_int_distribution<std::uint64_t> {recorder.now, recorder.now + 30}(engine));
+
+    const auto delay { std::uniform_int_distribution<std::uint64_t> {0, 9000}(engine) };
+    const auto period { i % 3 ? 0 : std::uniform_int_distribution<std::uint64_t> {1, 5000}(engine) };
+
+    const auto handle { recorder.schedule(delay, period) };
+
+    for (auto tick { recorder.now + std::max<std::uint64_t>(1, delay) }; tick <= until; tick += period)
+    {
+      expected[handle].push_back(tick);
+
+      if (not period)
+      {
+        break;
+      }
+    }
+  }
+
+  recorder.advance(until);
+
+  for (const auto& each : expected)
+  {
+    EXPECT_EQ(recorder.fired[each.first], each.second) << "timer " << each.first;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
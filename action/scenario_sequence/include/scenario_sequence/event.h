@@ -2,6 +2,7 @@
 #define SCENARIO_SEQUENCE_EVENT_H_INCLUDED
 
 #include <scenario_actions/action_manager.h>
+#include <scenario_actions/actor_selector.h>
 #include <scenario_entities/entity_manager.h>
 #include <scenario_expression/expression.h>
 #include <scenario_intersection/intersection_manager.h>
@@ -10,6 +11,22 @@
 namespace scenario_sequence
 {
 
+/* -----------------------------------------------------------------------------
+ *
+ * EVENT
+ *
+ * A resumable state machine, advanced by update once per tick:
+ *
+ *   queued    behind the current event of its sequence; its condition is
+ *             inactive, so its batched predicates are not updated
+ *   waiting   the condition is evaluated every tick until it holds, then it is
+ *             latched, deactivated and never evaluated again (ignited)
+ *   sleeping  for Delay [sec], if given, the event is suspended on the timer
+ *             wheel and costs nothing per tick: neither its condition nor the
+ *             batch pass of its predicates is evaluated
+ *   done      the actions are run, and the event succeeds
+ *
+ * -------------------------------------------------------------------------- */
 class Event
 {
   scenario_expression::Context context_;
@@ -18,15 +35,26 @@ class Event
 
   std::vector<std::string> actors_;
 
+  std::vector<scenario_actions::ActorSelector> selectors_;
+
   std::shared_ptr<scenario_actions::ActionManager> action_manager_;
 
   scenario_expression::Expression condition_;
 
+  double delay_;  // [sec] from ignition to the actions
+
   bool ignited_;
 
+  const std::shared_ptr<bool> due_;  // NOTE: Shared with the timer, which may outlive this event.
+
+  void fire();
+
 public:
   Event(const scenario_expression::Context&, const YAML::Node&);
 
+  // NOTE: While active, the batched predicates of the condition are updated every tick.
+  void activate(bool active);
+
   simulation_is update(
     const std::shared_ptr<scenario_intersection::IntersectionManager>&);
 };
@@ -2,6 +2,7 @@
 #define SCENARIO_SEQUENCE_EVENT_MANAGER_H_INCLUDED
 
 #include <queue>
+#include <vector>
 
 #include <ros/ros.h>
 
@@ -21,9 +22,14 @@ class EventManager
 
   std::queue<scenario_sequence::Event> events_;
 
+  // NOTE: Kept, so that their periodic actions run until the sequence ends.
+  std::vector<scenario_sequence::Event> fired_;
+
 public:
   EventManager(const scenario_expression::Context&, const YAML::Node&);
 
+  void activate(bool active);  // NOTE: The current event only.
+
   simulation_is update(
     const std::shared_ptr<scenario_intersection::IntersectionManager>&);
 };
@@ -14,6 +14,15 @@
 namespace scenario_sequence
 {
 
+/* -----------------------------------------------------------------------------
+ *
+ * SEQUENCE
+ *
+ * Waits for its start condition, which is latched once it holds (ignited),
+ * and then runs its events one after another. Only the current sequence is
+ * active: its start condition until it held, and its current event.
+ *
+ * -------------------------------------------------------------------------- */
 class Sequence
 {
   scenario_expression::Context context_;
@@ -29,6 +38,9 @@ class Sequence
 public:
   Sequence(const scenario_expression::Context&, const YAML::Node&);
 
+  // NOTE: While active, the batched predicates of the conditions it may evaluate are updated every tick.
+  void activate(bool active);
+
   simulation_is update(
     const std::shared_ptr<scenario_intersection::IntersectionManager>&);
 };
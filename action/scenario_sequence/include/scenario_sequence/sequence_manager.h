@@ -22,6 +22,8 @@ class SequenceManager
 
   scenario_expression::Context context_;
 
+  void activate();  // NOTE: The current sequence only.
+
 public:
   SequenceManager(const scenario_expression::Context&, const YAML::Node&);
 
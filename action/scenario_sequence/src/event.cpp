@@ -8,33 +8,79 @@ Event::Event(
   const YAML::Node& event_definition)
   : context_ { context }
   , name_ {event_definition["Name"].as<std::string>()}
+  // NOTE: Not read_optional, which warns about every event without Delay.
+  , delay_ {event_definition["Delay"] ? event_definition["Delay"].as<double>() : 0.0}
   , ignited_ {false}
+  , due_ {std::make_shared<bool>(false)}
 {
   for (const auto& each : event_definition["Actors"])
   {
-    actors_.push_back(each.as<std::string>());
+    if (each.IsMap())
+    {
+      selectors_.emplace_back(each);
+    }
+    else
+    {
+      actors_.push_back(each.as<std::string>());
+    }
   }
 
   action_manager_ =
     std::make_shared<scenario_actions::ActionManager>(
-      event_definition["Actions"], actors_, context.api_pointer());
+      event_definition["Actions"], actors_, context.api_pointer(), context.timer_wheel_pointer(),
+      not selectors_.empty());
 
   if (const auto condition { event_definition["Condition"] })
   {
-    condition_ = scenario_expression::read(context_, condition);
+    condition_ =
+      scenario_expression::optimize(context_, scenario_expression::read(context_, condition));
   }
-  else // NOTE: If Condition unspecified, the sequence starts unconditionally.
+  else // NOTE: If Condition unspecified, the event fires unconditionally.
   {
-    ignited_ = true;
+    condition_ = scenario_expression::Expression::make<scenario_expression::Boolean>(true);
+  }
+
+  activate(false);  // NOTE: Until it is the current event (see EventManager).
+
+  if (delay_ < 0)
+  {
+    SCENARIO_ERROR_THROW(CATEGORY(), "Delay of event " << name_ << " must not be negative.");
+  }
+  else if (0 < delay_ and not context_.timer_wheel_pointer())
+  {
+    SCENARIO_WARN_STREAM(CATEGORY(), "Delay of event " << name_ << " is ignored here (no timer wheel).");
+    delay_ = 0;
   }
 }
 
 simulation_is Event::update(
   const std::shared_ptr<scenario_intersection::IntersectionManager>&)
 {
-  if (ignited_ = condition_.evaluate(context_))
+  if (not ignited_)
   {
-    (*action_manager_).run(context_.intersections_pointer());
+    if (not (ignited_ = condition_.evaluate(context_)))
+    {
+      return simulation_is::ongoing;
+    }
+
+    scenario_expression::activate(context_, condition_, false);
+
+    if (0 < delay_)
+    {
+      context_.timer_wheel().schedule(delay_, [due = due_]()
+      {
+        *due = true;
+      });
+    }
+    else
+    {
+      *due_ = true;
+    }
+  }
+
+  if (*due_)
+  {
+    fire();
     return simulation_is::succeeded;
   }
   else
@@ -43,5 +89,37 @@ simulation_is Event::update(
   }
 }
 
+void Event::activate(bool active)
+{
+  if (not ignited_)
+  {
+    scenario_expression::activate(context_, condition_, active);
+  }
+}
+
+void Event::fire()
+{
+  // NOTE: Measured only if the runner defined the dispatch latency (opt-in).
+  auto firing {
+    context_.dispatch_latency_pointer()
+      ? context_.dispatch_latency().fire(name_)
+      : scenario_logger::DispatchLatency::Firing()
+  };
+
+  if (not selectors_.empty())
+  {
+    auto actors { actors_ };
+
+    for (const auto& each : selectors_)
+    {
+      each.select(context_.entity_index(), context_.api(), actors);
+    }
+
+    (*action_manager_).setActors(actors);
+  }
+
+  (*action_manager_).run(context_.intersections_pointer(), &firing);
+}
+
 } // namespace scenario_sequence
 
@@ -14,6 +14,14 @@ EventManager::EventManager(
   }
 }
 
+void EventManager::activate(bool active)
+{
+  if (not events_.empty())
+  {
+    events_.front().activate(active);
+  }
+}
+
 simulation_is EventManager::update(
   const std::shared_ptr<scenario_intersection::IntersectionManager>&)
 {
@@ -22,7 +30,9 @@ simulation_is EventManager::update(
     switch (const auto result { events_.front().update(context_.intersections_pointer()) })
     {
     case simulation_is::succeeded:
+      fired_.push_back(std::move(events_.front()));
       events_.pop();
+      activate(true);
       return simulation_is::ongoing;
 
     default:
@@ -16,7 +16,10 @@ Sequence::Sequence(
 
   if (const auto start_condition { sequence_definition["StartCondition"] })
   {
-    start_condition_ = scenario_expression::read(context_, start_condition);
+    start_condition_ =
+      scenario_expression::optimize(context_, scenario_expression::read(context_, start_condition));
+
+    scenario_expression::activate(context_, start_condition_, false);  // NOTE: See SequenceManager.
   }
   else // NOTE: If StartCondition unspecified, the sequence starts unconditionally.
   {
@@ -24,10 +27,27 @@ Sequence::Sequence(
   }
 }
 
+void Sequence::activate(bool active)
+{
+  if (not ignited_)
+  {
+    scenario_expression::activate(context_, start_condition_, active);
+  }
+
+  // NOTE: Also while waiting, as the current event is evaluated in the tick the sequence starts.
+  (*event_manager_).activate(active);
+}
+
 simulation_is Sequence::update(
   const std::shared_ptr<scenario_intersection::IntersectionManager>&)
 {
-  if (ignited_ = start_condition_.evaluate(context_))
+  // NOTE: Latched, so that the start condition costs nothing once it held.
+  if (not ignited_ and (ignited_ = start_condition_.evaluate(context_)))
+  {
+    scenario_expression::activate(context_, start_condition_, false);
+  }
+
+  if (ignited_)
   {
     return (*event_manager_).update(context_.intersections_pointer());
   }
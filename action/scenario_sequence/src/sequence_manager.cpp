@@ -11,6 +11,16 @@ SequenceManager::SequenceManager(
   {
     sequences_.emplace(context, each["Sequence"]);
   }
+
+  activate();
+}
+
+void SequenceManager::activate()
+{
+  if (not sequences_.empty())
+  {
+    sequences_.front().activate(true);
+  }
 }
 
 simulation_is SequenceManager::update(
@@ -22,6 +32,7 @@ simulation_is SequenceManager::update(
     {
     case simulation_is::succeeded:
       sequences_.pop();
+      activate();
       return simulation_is::ongoing;
 
     default:
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SCENARIO_API_SCENARIO_API_CONFLICT_ZONES_H_INCLUDED
+#define SCENARIO_API_SCENARIO_API_CONFLICT_ZONES_H_INCLUDED
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <scenario_api/scenario_api_entity_state.h>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Areas where paths of different road users cross, derived from the lanelet
+ * map once: the overlap of every pair of conflicting lanelets (as reported by
+ * the routing graph) and every crosswalk. Zones are indexed by an R-tree, and
+ * entity footprints are mapped to zones once per tick.
+ */
+class ScenarioAPIConflictZones
+{
+public:
+  struct Zone
+  {
+    std::string kind;                  //!< @brief "Lanelet" (overlap) or "Crosswalk"
+    std::vector<lanelet::Id> lanelets;  //!< @brief lanelets that form this zone
+    Polygon polygon;
+  };
+
+  /**
+   * @brief constructor
+   */
+  ScenarioAPIConflictZones();
+
+  /**
+   * @brief destructor
+   */
+  ~ScenarioAPIConflictZones();
+
+  bool isBuilt() const;
+  void build(
+    const lanelet::LaneletMapPtr & lanelet_map_ptr,
+    const lanelet::routing::RoutingGraphPtr & routing_graph_ptr);
+  void update(const std::vector<EntityState> & entities);
+
+  const std::vector<Zone> & getZones() const;
+  bool isInConflictZone(const std::string & name, const int lane_id = -1) const;
+  bool isConflictZoneOccupiedByOther(
+    const std::string & name, const std::string & other_name = "") const;
+
+private:
+  using Box = bg::model::box<Point>;
+  using RTree = bg::index::rtree<std::pair<Box, std::size_t>, bg::index::rstar<16>>;
+
+  bool built_;
+  std::vector<Zone> zones_;
+  RTree rtree_;
+
+  std::unordered_map<std::string, std::vector<std::size_t>> entity_zones_;  //!< @brief name -> zones
+  std::vector<std::vector<std::string>> zone_occupants_;                   //!< @brief zone -> names
+
+  void addZone(const std::string & kind, std::vector<lanelet::Id> lanelets, const Polygon & poly);
+};
+
+#endif  // SCENARIO_API_SCENARIO_API_CONFLICT_ZONES_H_INCLUDED
@@ -21,7 +21,16 @@
 #include <tf2_ros/static_transform_broadcaster.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+
+/*
+ * Frames are registered rarely and looked up on every tick, possibly from
+ * other threads: the map is copied on write and published as an immutable
+ * snapshot (std::atomic_store), so that getRelativePose never locks, while
+ * writers are serialized by write_mutex_.
+ */
 class ScenarioAPICoordinateManager
 {
 public:
@@ -40,5 +49,8 @@ public:
   geometry_msgs::Pose getRelativePose(const std::string frame_id, const geometry_msgs::Pose pose);
 
 private:
-  std::unordered_map<std::string, tf2::Transform> coordinate_map_;
+  using CoordinateMap = std::unordered_map<std::string, tf2::Transform>;
+
+  std::shared_ptr<const CoordinateMap> coordinate_map_;  //!< @brief via std::atomic_load/store
+  std::mutex write_mutex_;                               //!< @brief serializes setFrameId
 };
\ No newline at end of file
@@ -33,7 +33,11 @@
 #include <pcl/point_types.h>
 #include <pcl_conversions/pcl_conversions.h>
 #include <ros/ros.h>
+#include <scenario_api/scenario_api_conflict_zones.h>
+#include <scenario_api/scenario_api_obstacle_grid.h>
 #include <scenario_api/scenario_api_coordinate_manager.h>
+#include <scenario_api/scenario_api_entity_state.h>
+#include <scenario_api/scenario_api_lane_assigner.h>
 #include <scenario_api/scenario_calc_dist_utils.h>
 #include <scenario_api_autoware/scenario_api_autoware.h>
 #include <scenario_api_simulator/scenario_api_simulator.h>
@@ -80,6 +84,15 @@ class TrafficRules;
 }
 }  // namespace lanelet
 
+/*
+ * Threading model
+ *
+ * The members delegated to ScenarioAPIAutoware and ScenarioAPICoordinateManager
+ * may be called from any thread (see their own notes). The entity snapshot,
+ * the obstacle grids and the NPC registry below belong to the thread that
+ * drives the scenario (updateEntityStates, addNPC and the conditions evaluated
+ * in the same tick), and are not meant to be touched from other threads.
+ */
 class ScenarioAPI
 {
 public:
@@ -197,6 +210,8 @@ public:
 
   // obstacle API
   double getMinimumDistanceToObstacle(bool consider_height);
+  double getDistanceToObstacle(
+    const Polygon & footprint, bool consider_height);  //!< @brief footprint in map frame
 
   // NPC API
   bool addNPC(
@@ -238,6 +253,16 @@ public:
   std::vector<std::string> getNpcList();
   bool isNpcExist(const std::string & name);
 
+  // entity API (ego-car and NPC)
+  bool updateEntityStates();  //!< @brief take snapshot of all entities and assign lanes (once per tick)
+  const std::vector<EntityState> & getEntityStates() const;
+  bool getEntityLaneID(const std::string & name, int & lane_id);
+  bool getEntitySpeedLimit(const std::string & name, double & speed_limit);  //!< @brief [m/s]
+  bool isInSameLane(const std::string & name1, const std::string & name2);
+  bool isInConflictZone(const std::string & name, const int lane_id = -1);
+  bool isConflictZoneOccupiedByOther(
+    const std::string & name, const std::string & other_name = "");
+
   // traffic light API
   bool setTrafficLightColor(
     const int traffic_id, const std::string traffic_color,
@@ -305,6 +330,13 @@ private:
   std::shared_ptr<ScenarioAPISimulator> simulator_api_;
   std::shared_ptr<ScenarioAPIAutoware> autoware_api_;
   std::shared_ptr<ScenarioAPICoordinateManager> coordinate_api_;
+  std::shared_ptr<ScenarioAPILaneAssigner> lane_assigner_;
+  std::shared_ptr<ScenarioAPIConflictZones> conflict_zones_;
+  std::shared_ptr<ScenarioAPIObstacleGrid> obstacle_grid_;     //!< @brief points in vehicle height
+  std::shared_ptr<ScenarioAPIObstacleGrid> obstacle_grid_2d_;  //!< @brief all points
+
+  std::vector<EntityState> entity_states_;  //!< @brief snapshot taken by updateEntityStates
+  std::unordered_map<std::string, std::string> npc_types_;  //!< @brief type given to addNPC, by name
 
   std::string ego_car_name_ = "";
   bool is_autoware_ready_initialize;
@@ -349,8 +381,7 @@ private:
   double getRateInLane();  // TODO get percentage of body in lanelet polygon
 
   // function for obstacle API
-  double calcMinimumDistanceToObstacle(
-    const std::shared_ptr<sensor_msgs::PointCloud2> & pointcloud, const bool consider_height);
+  const ScenarioAPIObstacleGrid & getObstacleGrid(const bool consider_height);
 
   // NPC API
   bool getNPC(
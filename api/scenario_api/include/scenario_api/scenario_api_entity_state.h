@@ -0,0 +1,39 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SCENARIO_API_SCENARIO_API_ENTITY_STATE_H_INCLUDED
+#define SCENARIO_API_SCENARIO_API_ENTITY_STATE_H_INCLUDED
+
+#include <geometry_msgs/Pose.h>
+#include <geometry_msgs/Twist.h>
+#include <geometry_msgs/Vector3.h>
+#include <scenario_api_utils/scenario_api_utils.h>
+
+#include <string>
+
+/* snapshot of one entity (ego-car or NPC), taken once per tick */
+struct EntityState
+{
+  std::string name;
+  std::string type;             //!< @brief "Ego" for ego-car, NPC type otherwise (may be empty)
+  geometry_msgs::Pose pose;     //!< @brief pose in map frame
+  geometry_msgs::Twist twist;   //!< @brief twist in body frame
+  geometry_msgs::Vector3 size;  //!< @brief bounding box size (x: length, y: width, z: height)
+  Polygon footprint;            //!< @brief 2D footprint in map frame
+};
+
+#endif  // SCENARIO_API_SCENARIO_API_ENTITY_STATE_H_INCLUDED
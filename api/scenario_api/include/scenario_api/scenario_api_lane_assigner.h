@@ -0,0 +1,76 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SCENARIO_API_SCENARIO_API_LANE_ASSIGNER_H_INCLUDED
+#define SCENARIO_API_SCENARIO_API_LANE_ASSIGNER_H_INCLUDED
+
+#include <lanelet2_core/LaneletMap.h>
+#include <scenario_api/scenario_api_entity_state.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Assigns a lanelet to every entity in one batch per tick.
+ *
+ * The lanelet assigned on the previous tick is tried first (entities rarely
+ * leave their lanelet between ticks); only the entities it does not contain
+ * fall back to a nearest-neighbour query on the lanelet layer's R-tree. The
+ * heading checks of all candidates are evaluated together over flat arrays.
+ */
+class ScenarioAPILaneAssigner
+{
+public:
+  /**
+   * @brief constructor
+   */
+  ScenarioAPILaneAssigner();
+
+  /**
+   * @brief destructor
+   */
+  ~ScenarioAPILaneAssigner();
+
+  void assign(
+    const std::vector<EntityState> & entities, const lanelet::LaneletMapPtr & lanelet_map_ptr,
+    double max_dist = 3.0, double max_delta_yaw = M_PI / 4.0);
+
+  bool getLaneID(const std::string & name, lanelet::Id & lane_id) const;
+
+private:
+  /* struct of arrays: one element per (entity, lanelet) candidate */
+  struct Candidates
+  {
+    std::vector<std::size_t> owner;  //!< @brief index of entity
+    std::vector<lanelet::Id> lane_id;
+    std::vector<double> distance;
+    std::vector<double> entity_yaw;
+    std::vector<double> lane_yaw;
+    std::vector<char> accepted;
+
+    void clear();
+    void push(std::size_t owner, const lanelet::ConstLanelet & lanelet, double distance,
+      const geometry_msgs::Pose & pose);
+    void evaluate(double max_dist, double max_delta_yaw);
+  };
+
+  Candidates candidates_;  //!< @brief reused across ticks to avoid reallocation
+  std::unordered_map<std::string, lanelet::Id> assignment_;
+};
+
+#endif  // SCENARIO_API_SCENARIO_API_LANE_ASSIGNER_H_INCLUDED
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SCENARIO_API_SCENARIO_API_OBSTACLE_GRID_H_INCLUDED
+#define SCENARIO_API_SCENARIO_API_OBSTACLE_GRID_H_INCLUDED
+
+#include <scenario_api_utils/scenario_api_utils.h>
+#include <sensor_msgs/PointCloud2.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * The obstacle point cloud (base_link frame) rasterized into a square 2D
+ * occupancy grid around the ego-car, with the exact Euclidean distance
+ * transform of the occupied cells. Built once per cloud; afterwards the
+ * clearance of any footprint is bounded by a few lookups along its boundary
+ * plus one prefix-sum query per row inside it, and only the points within
+ * that bound are measured, instead of every point of the cloud.
+ *
+ * Distances are exact, as those of calcDistFromPolygonToPointCloud: the
+ * points outside the grid are measured whenever the bound reaches beyond it,
+ * and max_distance is returned if nothing is nearer. The returns of the
+ * queried object itself (e.g. an NPC that is published to the cloud) are not
+ * excluded. As before, a cloud that is missing or not in base_link yields a
+ * short distance (0.0).
+ */
+class ScenarioAPIObstacleGrid
+{
+public:
+  static constexpr double max_distance = 1000.0;  //!< @brief returned when no obstacle is found
+
+  /**
+   * @brief constructor
+   * @param [in] resolution cell size [m]
+   * @param [in] range half width of the grid [m]
+   */
+  ScenarioAPIObstacleGrid(const double resolution = 0.2, const double range = 50.0);
+
+  /**
+   * @brief destructor
+   */
+  ~ScenarioAPIObstacleGrid();
+
+  bool isBuiltFrom(const std::shared_ptr<sensor_msgs::PointCloud2> & pointcloud_ptr) const;
+
+  /**
+   * @brief rasterize a cloud
+   * @param [in] base_link_pose pose of the ego-car in map frame when the cloud was recorded
+   */
+  bool build(
+    const std::shared_ptr<sensor_msgs::PointCloud2> & pointcloud_ptr,
+    const geometry_msgs::Pose & base_link_pose, const bool consider_height, const double top,
+    const double bottom);
+
+  double getDistance(const Polygon & poly) const;       //!< @brief polygon in base_link frame
+  double getDistanceInMap(const Polygon & poly) const;  //!< @brief polygon in map frame
+
+private:
+  const double resolution_;
+  const int size_;       //!< @brief cells per side
+  const double origin_;  //!< @brief base_link coordinate of the grid corner (both axes)
+
+  std::shared_ptr<sensor_msgs::PointCloud2> source_;  //!< @brief cloud the grid was built from
+  SE2 map2grid_;                                      //!< @brief map -> base_link when the cloud was recorded
+
+  std::vector<std::uint32_t> row_sums_;     //!< @brief per-row prefix sums of occupied cells
+  std::vector<std::uint32_t> cell_starts_;  //!< @brief index of the first point of each cell, then the end
+  std::vector<Point> points_;               //!< @brief points in the grid, ordered by cell
+  std::vector<Point> outside_;              //!< @brief points beyond the grid
+  std::vector<float> distances_;            //!< @brief distance between the centers of a cell and the nearest occupied one [m]
+  bool valid_;                              //!< @brief built from a usable cloud
+  bool empty_;                              //!< @brief no occupied cell
+
+  bool toCell(const double x, const double y, int & ix, int & iy) const;
+  std::uint32_t countOccupied(const Polygon & poly) const;
+  double getCellDistance(const double x, const double y) const;  //!< @brief point in base_link frame
+  double getUpperBound(const Polygon & poly) const;  //!< @brief of the distance of a polygon in base_link frame
+};
+
+#endif  // SCENARIO_API_SCENARIO_API_OBSTACLE_GRID_H_INCLUDED
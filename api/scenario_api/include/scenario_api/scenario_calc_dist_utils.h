@@ -34,4 +34,8 @@ Polygon makeRelativePolygonFromSelf(
 
 double calcDistOfPolygon(const Polygon poly, const Polygon poly2);
 
+Polygon transformPolygon(const Polygon poly, const geometry_msgs::Pose pose);
+
+Polygon makeAbsolutePolygon(const geometry_msgs::Pose obj_pose, const geometry_msgs::Vector3 obj_size);
+
 #endif  // SCENARIO_API_SCENARIO_API_CALC_DIST_UTILS_H_INCLUDED
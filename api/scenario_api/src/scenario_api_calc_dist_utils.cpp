@@ -30,43 +30,51 @@ Polygon makeRelativePolygonFromSelf(
   const geometry_msgs::Pose self_pose, const geometry_msgs::Pose obj_pose,
   const geometry_msgs::Vector3 obj_size)
 {
-  // get object position
-  double obj_x = obj_pose.position.x;
-  double obj_y = obj_pose.position.y;
-  double obj_yaw = yawFromQuat(obj_pose.orientation);
-
-  // get self position
-  double self_x = self_pose.position.x;
-  double self_y = self_pose.position.y;
-  double self_yaw = yawFromQuat(self_pose.orientation);
-
-  // calculate distance x, y *in self-centered coordinate*
-  double dif_x = (obj_x - self_x) * std::cos(-self_yaw) - (obj_y - self_y) * std::sin(-self_yaw);
-  double dif_y = (obj_x - self_x) * std::sin(-self_yaw) + (obj_y - self_y) * std::cos(-self_yaw);
-  double dif_yaw = obj_yaw - self_yaw;
+  // object pose *in self-centered coordinate*
+  const SE2 self2obj = SE2::fromPose(self_pose).inverse() * SE2::fromPose(obj_pose);
 
   // rename
-  double h = obj_size.x;  // object height
-  double w = obj_size.y;  // object width
+  const double h = obj_size.x;  // object height
+  const double w = obj_size.y;  // object width
 
-  // create object polygon *in self-centered coordinate*
-  Polygon obj_poly;
+  // base polygon -> polygon *in self-centered coordinate*
+  double xs[] = {h / 2.0, -h / 2.0, -h / 2.0, h / 2.0, h / 2.0};
+  double ys[] = {w / 2.0, w / 2.0, -w / 2.0, -w / 2.0, w / 2.0};
+  self2obj.transform(xs, ys, xs, ys, 5);
 
-  // base polygon
-  bg::exterior_ring(obj_poly) = boost::assign::list_of<Point>(h / 2.0, w / 2.0)(-h / 2.0, w / 2.0)(
-    -h / 2.0, -w / 2.0)(h / 2.0, -w / 2.0)(h / 2.0, w / 2.0);
-  // rotation
-  bt::rotate_transformer<bg::radian, double, 2, 2> rotate(-dif_yaw);  // original:clockwise rotation
-  Polygon rotate_obj_poly;
-  bg::transform(obj_poly, rotate_obj_poly, rotate);
-  // translation
-  bt::translate_transformer<double, 2, 2> translate(dif_x, dif_y);  // original:clockwise rotation
-  Polygon translate_obj_poly;
-  bg::transform(rotate_obj_poly, translate_obj_poly, translate);
-  return translate_obj_poly;
+  Polygon obj_poly;
+  for (std::size_t i = 0; i < 5; ++i) {
+    bg::append(obj_poly.outer(), Point(xs[i], ys[i]));
+  }
+  return obj_poly;
 }
 
 double calcDistOfPolygon(const Polygon poly, const Polygon poly2)
 {
   return bg::distance(poly, poly2);
 }
+
+Polygon transformPolygon(const Polygon poly, const geometry_msgs::Pose pose)
+{
+  // polygon in pose-centered coordinate -> polygon in map coordinate
+  const SE2 map2pose = SE2::fromPose(pose);
+
+  Polygon transformed_poly;
+  transformed_poly.outer().reserve(poly.outer().size());
+  for (const auto & p : poly.outer()) {
+    transformed_poly.outer().emplace_back(
+      map2pose.transformX(p.x(), p.y()), map2pose.transformY(p.x(), p.y()));
+  }
+  return transformed_poly;
+}
+
+Polygon makeAbsolutePolygon(const geometry_msgs::Pose obj_pose, const geometry_msgs::Vector3 obj_size)
+{
+  const double h = obj_size.x;  // object length
+  const double w = obj_size.y;  // object width
+
+  Polygon obj_poly;
+  bg::exterior_ring(obj_poly) = boost::assign::list_of<Point>(h / 2.0, w / 2.0)(-h / 2.0, w / 2.0)(
+    -h / 2.0, -w / 2.0)(h / 2.0, -w / 2.0)(h / 2.0, w / 2.0);
+  return transformPolygon(obj_poly, obj_pose);
+}
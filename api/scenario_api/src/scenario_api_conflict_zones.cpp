@@ -0,0 +1,166 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <scenario_api/scenario_api_conflict_zones.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+Polygon toPolygon(const lanelet::ConstLanelet & lanelet)
+{
+  Polygon poly;
+  for (const auto & p : lanelet.polygon2d().basicPolygon()) {
+    bg::append(poly.outer(), Point(p.x(), p.y()));
+  }
+  bg::correct(poly);
+  return poly;
+}
+
+bool isCrosswalk(const lanelet::ConstLanelet & lanelet)
+{
+  return lanelet.hasAttribute(lanelet::AttributeName::Subtype) and
+         lanelet.attribute(lanelet::AttributeName::Subtype).value() ==
+           lanelet::AttributeValueString::Crosswalk;
+}
+}  // namespace
+
+ScenarioAPIConflictZones::ScenarioAPIConflictZones() : built_(false) {}
+
+ScenarioAPIConflictZones::~ScenarioAPIConflictZones() {}
+
+bool ScenarioAPIConflictZones::isBuilt() const { return built_; }
+
+void ScenarioAPIConflictZones::addZone(
+  const std::string & kind, std::vector<lanelet::Id> lanelets, const Polygon & poly)
+{
+  if (bg::area(poly) <= 0.0) {
+    return;
+  }
+  zones_.push_back(Zone{kind, std::move(lanelets), poly});
+}
+
+void ScenarioAPIConflictZones::build(
+  const lanelet::LaneletMapPtr & lanelet_map_ptr,
+  const lanelet::routing::RoutingGraphPtr & routing_graph_ptr)
+{
+  if (lanelet_map_ptr == nullptr or routing_graph_ptr == nullptr) {
+    return;
+  }
+
+  zones_.clear();
+
+  for (const auto & lanelet : lanelet_map_ptr->laneletLayer) {
+    if (isCrosswalk(lanelet)) {
+      addZone("Crosswalk", {lanelet.id()}, toPolygon(lanelet));
+      continue;
+    }
+
+    for (const auto & conflicting : routing_graph_ptr->conflicting(lanelet)) {
+      const auto other = conflicting.lanelet();
+      if (!other or other->id() <= lanelet.id()) {
+        continue;  // each pair once
+      }
+
+      bg::model::multi_polygon<Polygon> overlaps;
+      bg::intersection(toPolygon(lanelet), toPolygon(*other), overlaps);
+      for (const auto & overlap : overlaps) {
+        addZone("Lanelet", {lanelet.id(), other->id()}, overlap);
+      }
+    }
+  }
+
+  std::vector<std::pair<Box, std::size_t>> values;
+  values.reserve(zones_.size());
+  for (std::size_t i = 0; i < zones_.size(); ++i) {
+    values.emplace_back(bg::return_envelope<Box>(zones_[i].polygon), i);
+  }
+  rtree_ = RTree(values.begin(), values.end());  // bulk loading (packing)
+
+  zone_occupants_.assign(zones_.size(), {});
+  built_ = true;
+
+  ROS_INFO("Conflict zones are built (%zu zones)", zones_.size());
+}
+
+void ScenarioAPIConflictZones::update(const std::vector<EntityState> & entities)
+{
+  entity_zones_.clear();
+  for (auto & occupants : zone_occupants_) {
+    occupants.clear();
+  }
+
+  std::vector<std::pair<Box, std::size_t>> hits;
+  for (const auto & entity : entities) {
+    if (entity.footprint.outer().empty()) {
+      continue;
+    }
+
+    hits.clear();
+    rtree_.query(
+      bg::index::intersects(bg::return_envelope<Box>(entity.footprint)), std::back_inserter(hits));
+
+    auto & zones = entity_zones_[entity.name];
+    for (const auto & hit : hits) {
+      if (bg::intersects(entity.footprint, zones_[hit.second].polygon)) {
+        zones.push_back(hit.second);
+        zone_occupants_[hit.second].push_back(entity.name);
+      }
+    }
+  }
+}
+
+const std::vector<ScenarioAPIConflictZones::Zone> & ScenarioAPIConflictZones::getZones() const
+{
+  return zones_;
+}
+
+bool ScenarioAPIConflictZones::isInConflictZone(const std::string & name, const int lane_id) const
+{
+  const auto iter = entity_zones_.find(name);
+  if (iter == entity_zones_.end()) {
+    return false;
+  }
+
+  if (lane_id < 0) {
+    return !iter->second.empty();
+  }
+
+  return std::any_of(iter->second.begin(), iter->second.end(), [&](const std::size_t zone) {
+    const auto & lanelets = zones_[zone].lanelets;
+    return std::find(lanelets.begin(), lanelets.end(), lane_id) != lanelets.end();
+  });
+}
+
+bool ScenarioAPIConflictZones::isConflictZoneOccupiedByOther(
+  const std::string & name, const std::string & other_name) const
+{
+  const auto iter = entity_zones_.find(name);
+  if (iter == entity_zones_.end()) {
+    return false;
+  }
+
+  for (const auto zone : iter->second) {
+    for (const auto & occupant : zone_occupants_[zone]) {
+      if (occupant != name and (other_name.empty() or occupant == other_name)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
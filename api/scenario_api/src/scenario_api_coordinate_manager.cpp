@@ -16,7 +16,10 @@
 
 #include <scenario_api/scenario_api_coordinate_manager.h>
 
-ScenarioAPICoordinateManager::ScenarioAPICoordinateManager() {}
+ScenarioAPICoordinateManager::ScenarioAPICoordinateManager()
+: coordinate_map_(std::make_shared<CoordinateMap>())
+{
+}
 
 ScenarioAPICoordinateManager::~ScenarioAPICoordinateManager() {}
 
@@ -24,7 +27,9 @@ bool ScenarioAPICoordinateManager::setFrameId(
   const std::string frame_id, const geometry_msgs::Pose pose)
 {
   // TODO: now, source frame is only map
-  if (coordinate_map_.find(frame_id) != coordinate_map_.end()) {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  const auto coordinate_map = std::atomic_load(&coordinate_map_);
+  if (coordinate_map->find(frame_id) != coordinate_map->end()) {
     ROS_WARN("Frame:(id:%s) already exsists", frame_id.c_str());
     return false;
   }
@@ -37,8 +42,10 @@ bool ScenarioAPICoordinateManager::setFrameId(
   map2frame.setOrigin(position);
   map2frame.setRotation(orientation);
 
-  // register coordinate
-  coordinate_map_[frame_id] = map2frame;
+  // register coordinate (to a copy, so that readers of the current map are not disturbed)
+  auto new_coordinate_map = std::make_shared<CoordinateMap>(*coordinate_map);
+  (*new_coordinate_map)[frame_id] = map2frame;
+  std::atomic_store(&coordinate_map_, std::shared_ptr<const CoordinateMap>(new_coordinate_map));
 
   return true;
 }
@@ -48,7 +55,9 @@ geometry_msgs::Pose ScenarioAPICoordinateManager::getRelativePose(
 {
   geometry_msgs::Pose relative_pose;
 
-  if (coordinate_map_.find(frame_id) == coordinate_map_.end()) {
+  const auto coordinate_map = std::atomic_load(&coordinate_map_);
+  const auto frame = coordinate_map->find(frame_id);
+  if (frame == coordinate_map->end()) {
     ROS_WARN("Frame(id:%s) does not exsist", frame_id.c_str());
     return relative_pose;  // TODO return nullptr (change function type)
   }
@@ -60,7 +69,7 @@ geometry_msgs::Pose ScenarioAPICoordinateManager::getRelativePose(
   frame2newframe.setOrigin(position);
   frame2newframe.setRotation(orientation);
 
-  tf2::Transform map2frame = coordinate_map_[frame_id];
+  tf2::Transform map2frame = frame->second;
   tf2::Transform map2newframe = map2frame * frame2newframe;
   tf2::toMsg(map2newframe, relative_pose);
 
@@ -22,6 +22,17 @@ ScenarioAPI::ScenarioAPI()
   autoware_api_ = std::make_shared<ScenarioAPIAutoware>();
   simulator_api_ = std::make_shared<ScenarioAPISimulator>();
   coordinate_api_ = std::make_shared<ScenarioAPICoordinateManager>();
+  lane_assigner_ = std::make_shared<ScenarioAPILaneAssigner>();
+  conflict_zones_ = std::make_shared<ScenarioAPIConflictZones>();
+
+  ros::NodeHandle pnh("~");
+  double obstacle_grid_resolution, obstacle_grid_range;
+  pnh.param<double>("obstacle_grid_resolution", obstacle_grid_resolution, 0.2);
+  pnh.param<double>("obstacle_grid_range", obstacle_grid_range, 50.0);
+  obstacle_grid_ =
+    std::make_shared<ScenarioAPIObstacleGrid>(obstacle_grid_resolution, obstacle_grid_range);
+  obstacle_grid_2d_ =
+    std::make_shared<ScenarioAPIObstacleGrid>(obstacle_grid_resolution, obstacle_grid_range);
 }
 
 ScenarioAPI::~ScenarioAPI() {}
@@ -85,17 +96,16 @@ bool ScenarioAPI::sendCheckPoint(
 
 bool ScenarioAPI::sendStartVelocity(const double velocity)
 {
-  autoware_api_->sendStartVelocity(velocity);
-  //sleep for autoware path plan
-  //*if you engage autoware soon after using this API,
-  //*egp-vehicle decelerates after engage.
-  ros::Rate(1.0).sleep();
+  // no need to sleep here: if autoware is engaged soon after this,
+  // the ego decelerates after engage, so sendEngage waits for the ego to run at it
+  return autoware_api_->sendStartVelocity(velocity);
 }
 
 bool ScenarioAPI::sendEngage(const bool engage)
 {
-  autoware_api_->sendEngage(engage);
-  simulator_api_->sendEngage(engage);
+  const bool autoware_result = autoware_api_->sendEngage(engage);
+  const bool simulator_result = simulator_api_->sendEngage(engage);
+  return autoware_result and simulator_result;
 }
 
 bool ScenarioAPI::waitAutowareInitialize() { return autoware_api_->waitAutowareInitialize(); }
@@ -137,10 +147,10 @@ bool ScenarioAPI::isStopped(double thresh_velocity)
 
 bool ScenarioAPI::isInArea(geometry_msgs::Pose pose, double dist_thresh, double delta_yaw_thresh)
 {
-  double yaw = yawFromQuat(pose.orientation);
-  double delta_yaw = std::abs(normalizeRadian(getCurrentPose().yaw - yaw));
-  double delta_dist =
-    std::hypot(getCurrentPose().x - pose.position.x, getCurrentPose().y - pose.position.y);
+  const SE2 current = SE2::fromPose(getCurrentPoseRos().pose);
+  const SE2 target = SE2::fromPose(pose);
+  const double delta_yaw = std::abs(target.deltaYaw(current));
+  const double delta_dist = std::hypot(current.x - target.x, current.y - target.y);
   return (delta_dist < dist_thresh) and (delta_yaw < delta_yaw_thresh);
 }
 
@@ -156,19 +166,33 @@ bool ScenarioAPI::approveLaneChange(bool approve_lane_change)
 
 double ScenarioAPI::getMinimumDistanceToObstacle(bool consider_height)
 {
-  const std::shared_ptr<sensor_msgs::PointCloud2> pcl_ptr =
-    autoware_api_->getPointCloud();  // TODO ->move to sensor_api_->getPointCloud();
-  return calcMinimumDistanceToObstacle(pcl_ptr, consider_height);
+  return getObstacleGrid(consider_height).getDistance(autoware_api_->getSelfPolygon2D());
+}
+
+double ScenarioAPI::getDistanceToObstacle(const Polygon & footprint, bool consider_height)
+{
+  return getObstacleGrid(consider_height).getDistanceInMap(footprint);
 }
 
-double ScenarioAPI::calcMinimumDistanceToObstacle(
-  const std::shared_ptr<sensor_msgs::PointCloud2> & pointcloud_ptr, const bool consider_height)
+const ScenarioAPIObstacleGrid & ScenarioAPI::getObstacleGrid(const bool consider_height)
 {
-  // rename
-  const double top = autoware_api_->getVehicleTopFromBase();
-  const double bottom = autoware_api_->getVehicleBottomFromBase();
-  Polygon poly = autoware_api_->getSelfPolygon2D();
-  return calcDistFromPolygonToPointCloud(pointcloud_ptr, poly, consider_height, top, bottom);
+  const std::shared_ptr<sensor_msgs::PointCloud2> pcl_ptr =
+    autoware_api_->getPointCloud();  // TODO ->move to sensor_api_->getPointCloud();
+
+  // rebuilt at most once per cloud, on first query
+  auto & grid = consider_height ? obstacle_grid_ : obstacle_grid_2d_;
+  if (!grid->isBuiltFrom(pcl_ptr)) {
+    // rename
+    const double top = autoware_api_->getVehicleTopFromBase();
+    const double bottom = autoware_api_->getVehicleBottomFromBase();
+    // the cloud is in base_link when it was recorded, which the ego-car may have left since
+    geometry_msgs::Pose pose = getCurrentPoseRos().pose;
+    if (pcl_ptr != nullptr) {
+      autoware_api_->getPoseAt(pcl_ptr->header.stamp, pose);
+    }
+    grid->build(pcl_ptr, pose, consider_height, top, bottom);
+  }
+  return *grid;
 }
 
 bool ScenarioAPI::getCurrentLaneID(int & current_id, double max_dist, double max_delta_yaw)
@@ -190,7 +214,11 @@ bool ScenarioAPI::addNPC(
   const std::string & npc_type, const std::string & name, geometry_msgs::Pose pose,
   const double velocity, const bool stop_by_vehicle, const std::string & frame_type)
 {
-  return simulator_api_->addNPC(npc_type, name, pose, velocity, stop_by_vehicle, frame_type);
+  if (!simulator_api_->addNPC(npc_type, name, pose, velocity, stop_by_vehicle, frame_type)) {
+    return false;
+  }
+  npc_types_[name] = npc_type;
+  return true;
 }
 
 bool ScenarioAPI::changeNPCVelocity(const std::string & name, const double velocity)
@@ -338,6 +366,90 @@ std::vector<std::string> ScenarioAPI::getNpcList() { return simulator_api_->getN
 
 bool ScenarioAPI::isNpcExist(const std::string & name) { return true; }
 
+// entity API
+bool ScenarioAPI::updateEntityStates()
+{
+  entity_states_.clear();
+
+  if (!ego_car_name_.empty()) {
+    EntityState ego;
+    ego.name = ego_car_name_;
+    ego.type = "Ego";
+    ego.pose = autoware_api_->getCurrentPoseRos().pose;
+    ego.twist.linear.x = autoware_api_->getVelocity();
+    const Polygon self_poly = autoware_api_->getSelfPolygon2D();  // base_link-centered
+    bg::model::box<Point> self_box;
+    bg::envelope(self_poly, self_box);
+    ego.size.x = self_box.max_corner().x() - self_box.min_corner().x();
+    ego.size.y = self_box.max_corner().y() - self_box.min_corner().y();
+    ego.size.z = autoware_api_->getVehicleTopFromBase();
+    ego.footprint = transformPolygon(self_poly, ego.pose);
+    entity_states_.push_back(ego);
+  }
+
+  for (const auto & name : getNpcList()) {
+    EntityState npc;
+    std::string unused;
+    if (!getNPC(name, npc.pose, npc.twist, npc.size, unused)) {
+      continue;
+    }
+    npc.name = name;
+    const auto type = npc_types_.find(name);
+    if (type != npc_types_.end()) {
+      npc.type = type->second;
+    }
+    npc.footprint = makeAbsolutePolygon(npc.pose, npc.size);
+    entity_states_.push_back(npc);
+  }
+
+  lane_assigner_->assign(entity_states_, autoware_api_->getLaneletMap());
+
+  if (!conflict_zones_->isBuilt()) {
+    // built once, as soon as the map is received
+    conflict_zones_->build(autoware_api_->getLaneletMap(), autoware_api_->getRoutingGraph());
+  }
+  conflict_zones_->update(entity_states_);
+
+  return true;
+}
+
+const std::vector<EntityState> & ScenarioAPI::getEntityStates() const { return entity_states_; }
+
+bool ScenarioAPI::getEntityLaneID(const std::string & name, int & lane_id)
+{
+  lanelet::Id id;
+  if (!lane_assigner_->getLaneID(name, id)) {
+    return false;
+  }
+  lane_id = static_cast<int>(id);
+  return true;
+}
+
+bool ScenarioAPI::getEntitySpeedLimit(const std::string & name, double & speed_limit)
+{
+  // lane assigned by updateEntityStates, limit precomputed at map load
+  lanelet::Id id;
+  return lane_assigner_->getLaneID(name, id) and autoware_api_->getSpeedLimit(id, speed_limit);
+}
+
+bool ScenarioAPI::isInSameLane(const std::string & name1, const std::string & name2)
+{
+  lanelet::Id id1, id2;
+  return lane_assigner_->getLaneID(name1, id1) and lane_assigner_->getLaneID(name2, id2) and
+         id1 == id2;
+}
+
+bool ScenarioAPI::isInConflictZone(const std::string & name, const int lane_id)
+{
+  return conflict_zones_->isInConflictZone(name, lane_id);
+}
+
+bool ScenarioAPI::isConflictZoneOccupiedByOther(
+  const std::string & name, const std::string & other_name)
+{
+  return conflict_zones_->isConflictZoneOccupiedByOther(name, other_name);
+}
+
 // traffic light API
 bool ScenarioAPI::setTrafficLightColor(
   const int traffic_id, const std::string traffic_color, const bool use_traffic_light)
@@ -465,12 +577,10 @@ bool ScenarioAPI::isObjectInArea(
       return false;
     }
   }
-  const auto npc_yaw = yawFromQuat(obj_pose.orientation);
-  const auto yaw = yawFromQuat(shift_pose.orientation);
-  double delta_yaw = std::abs(normalizeRadian(npc_yaw - yaw));
-  double delta_dist = sqrt(
-    std::pow(obj_pose.position.x - shift_pose.position.x, 2) +
-    std::pow(obj_pose.position.y - shift_pose.position.y, 2));
+  const SE2 obj = SE2::fromPose(obj_pose);
+  const SE2 target = SE2::fromPose(shift_pose);
+  const double delta_yaw = std::abs(target.deltaYaw(obj));
+  const double delta_dist = std::hypot(obj.x - target.x, obj.y - target.y);
   return (delta_dist < dist_thresh) and (delta_yaw < delta_yaw_thresh);
 }
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <lanelet2_core/geometry/Lanelet.h>
+#include <lanelet2_extension/utility/utilities.h>
+#include <scenario_api/scenario_api_lane_assigner.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+ScenarioAPILaneAssigner::ScenarioAPILaneAssigner() {}
+
+ScenarioAPILaneAssigner::~ScenarioAPILaneAssigner() {}
+
+void ScenarioAPILaneAssigner::Candidates::clear()
+{
+  owner.clear();
+  lane_id.clear();
+  distance.clear();
+  entity_yaw.clear();
+  lane_yaw.clear();
+  accepted.clear();
+}
+
+void ScenarioAPILaneAssigner::Candidates::push(
+  std::size_t index, const lanelet::ConstLanelet & lanelet, double dist,
+  const geometry_msgs::Pose & pose)
+{
+  owner.push_back(index);
+  lane_id.push_back(lanelet.id());
+  distance.push_back(dist);
+  entity_yaw.push_back(yawFromQuat(pose.orientation));
+  lane_yaw.push_back(lanelet::utils::getLaneletAngle(lanelet, pose.position));
+}
+
+void ScenarioAPILaneAssigner::Candidates::evaluate(double max_dist, double max_delta_yaw)
+{
+  const std::size_t size = owner.size();
+  accepted.resize(size);
+
+  // branch-free so that the loop vectorizes
+  constexpr double two_pi = 2.0 * M_PI;
+  for (std::size_t i = 0; i < size; ++i) {
+    const double diff = entity_yaw[i] - lane_yaw[i];
+    const double delta_yaw = std::abs(diff - two_pi * std::nearbyint(diff / two_pi));
+    accepted[i] = (distance[i] < max_dist) & (delta_yaw < max_delta_yaw);
+  }
+}
+
+void ScenarioAPILaneAssigner::assign(
+  const std::vector<EntityState> & entities, const lanelet::LaneletMapPtr & lanelet_map_ptr,
+  double max_dist, double max_delta_yaw)
+{
+  if (lanelet_map_ptr == nullptr) {
+    assignment_.clear();
+    return;
+  }
+
+  auto & layer = lanelet_map_ptr->laneletLayer;
+
+  std::vector<double> best_distance(entities.size(), std::numeric_limits<double>::max());
+  std::vector<lanelet::Id> best_id(entities.size(), lanelet::InvalId);
+
+  const auto select = [&]() {
+    for (std::size_t i = 0; i < candidates_.owner.size(); ++i) {
+      const auto owner = candidates_.owner[i];
+      if (candidates_.accepted[i] and candidates_.distance[i] < best_distance[owner]) {
+        best_distance[owner] = candidates_.distance[i];
+        best_id[owner] = candidates_.lane_id[i];
+      }
+    }
+  };
+
+  // pass 1: the lanelet assigned on the previous tick, if it still contains the entity
+  candidates_.clear();
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    const auto hint = assignment_.find(entities[i].name);
+    if (hint == assignment_.end() or not layer.exists(hint->second)) {
+      continue;
+    }
+    const auto lanelet = layer.get(hint->second);
+    const lanelet::BasicPoint2d point(entities[i].pose.position.x, entities[i].pose.position.y);
+    if (lanelet::geometry::inside(lanelet, point)) {
+      candidates_.push(i, lanelet, 0.0, entities[i].pose);
+    }
+  }
+  candidates_.evaluate(max_dist, max_delta_yaw);
+  select();
+
+  // pass 2: nearest-neighbour query for the rest
+  candidates_.clear();
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    if (best_id[i] != lanelet::InvalId) {
+      continue;
+    }
+    const lanelet::BasicPoint2d point(entities[i].pose.position.x, entities[i].pose.position.y);
+    for (const auto & nearest : lanelet::geometry::findNearest(layer, point, 10)) {
+      if (nearest.first < max_dist) {
+        candidates_.push(i, nearest.second, nearest.first, entities[i].pose);
+      }
+    }
+  }
+  candidates_.evaluate(max_dist, max_delta_yaw);
+  select();
+
+  assignment_.clear();
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    if (best_id[i] != lanelet::InvalId) {
+      assignment_.emplace(entities[i].name, best_id[i]);
+    }
+  }
+}
+
+bool ScenarioAPILaneAssigner::getLaneID(const std::string & name, lanelet::Id & lane_id) const
+{
+  const auto iter = assignment_.find(name);
+  if (iter == assignment_.end()) {
+    return false;
+  }
+  lane_id = iter->second;
+  return true;
+}
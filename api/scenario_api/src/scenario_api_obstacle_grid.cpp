@@ -0,0 +1,352 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <scenario_api/scenario_api_obstacle_grid.h>
+
+#include <sensor_msgs/point_cloud2_iterator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+constexpr float infinity = 1e20f;
+
+/*
+ * squared distance transform of a sampled 1D function (Felzenszwalb and
+ * Huttenlocher, "Distance Transforms of Sampled Functions", 2012), i.e. the
+ * lower envelope of the parabolas rooted at the finite samples.
+ * v and z are work buffers of n and n + 1 elements.
+ */
+void transform1D(const float * f, float * d, const int n, int * v, double * z)
+{
+  const auto parabola = [&](const int q) { return f[q] + static_cast<double>(q) * q; };
+
+  int k = -1;
+  for (int q = 0; q < n; ++q) {
+    if (f[q] >= infinity) {
+      continue;
+    }
+    double s = -std::numeric_limits<double>::infinity();
+    while (0 <= k) {
+      s = (parabola(q) - parabola(v[k])) / (2.0 * (q - v[k]));
+      if (z[k] < s) {
+        break;
+      }
+      --k;
+    }
+    ++k;
+    v[k] = q;
+    z[k] = (k == 0) ? -std::numeric_limits<double>::infinity() : s;
+    z[k + 1] = std::numeric_limits<double>::infinity();
+  }
+
+  if (k < 0) {
+    for (int q = 0; q < n; ++q) {
+      d[q] = infinity;
+    }
+    return;
+  }
+
+  k = 0;
+  for (int q = 0; q < n; ++q) {
+    while (z[k + 1] < q) {
+      ++k;
+    }
+    const double delta = q - v[k];
+    d[q] = static_cast<float>(delta * delta + f[v[k]]);
+  }
+}
+}  // namespace
+
+ScenarioAPIObstacleGrid::ScenarioAPIObstacleGrid(const double resolution, const double range)
+: resolution_(resolution),
+  size_(static_cast<int>(std::ceil(2.0 * range / resolution))),
+  origin_(-0.5 * size_ * resolution),
+  row_sums_(static_cast<std::size_t>(size_) * (size_ + 1), 0),
+  cell_starts_(static_cast<std::size_t>(size_) * size_ + 1, 0),
+  distances_(static_cast<std::size_t>(size_) * size_, infinity),
+  valid_(false),
+  empty_(true)
+{
+}
+
+ScenarioAPIObstacleGrid::~ScenarioAPIObstacleGrid() {}
+
+bool ScenarioAPIObstacleGrid::isBuiltFrom(
+  const std::shared_ptr<sensor_msgs::PointCloud2> & pointcloud_ptr) const
+{
+  return source_ != nullptr and source_ == pointcloud_ptr;
+}
+
+bool ScenarioAPIObstacleGrid::toCell(const double x, const double y, int & ix, int & iy) const
+{
+  const double fx = std::floor((x - origin_) / resolution_);
+  const double fy = std::floor((y - origin_) / resolution_);
+  if (fx < 0.0 or size_ <= fx or fy < 0.0 or size_ <= fy) {
+    return false;
+  }
+  ix = static_cast<int>(fx);
+  iy = static_cast<int>(fy);
+  return true;
+}
+
+bool ScenarioAPIObstacleGrid::build(
+  const std::shared_ptr<sensor_msgs::PointCloud2> & pointcloud_ptr,
+  const geometry_msgs::Pose & base_link_pose, const bool consider_height, const double top,
+  const double bottom)
+{
+  source_ = pointcloud_ptr;
+  map2grid_ = SE2::fromPose(base_link_pose).inverse();
+  valid_ = false;
+  empty_ = true;
+  points_.clear();
+  outside_.clear();
+
+  if (pointcloud_ptr == nullptr) {
+    return false;
+  }
+
+  if (pointcloud_ptr->header.frame_id != "base_link") {
+    ROS_WARN_THROTTLE(5.0, "frame_id of point cloud must be base_link");
+    return false;
+  }
+
+  valid_ = true;
+
+  /* rasterize, keeping the points of every cell */
+  std::fill(distances_.begin(), distances_.end(), infinity);
+  std::fill(cell_starts_.begin(), cell_starts_.end(), 0);
+
+  std::vector<int> cells;
+
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(*pointcloud_ptr, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(*pointcloud_ptr, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(*pointcloud_ptr, "z");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    if (consider_height and not(bottom <= *iter_z and *iter_z <= top)) {
+      continue;
+    }
+    int ix, iy;
+    if (toCell(*iter_x, *iter_y, ix, iy)) {
+      const int cell = iy * size_ + ix;
+      distances_[cell] = 0.0f;
+      ++cell_starts_[cell + 1];
+      cells.push_back(cell);
+      points_.emplace_back(*iter_x, *iter_y);
+      empty_ = false;
+    } else {
+      outside_.emplace_back(*iter_x, *iter_y);
+    }
+  }
+
+  /* points ordered by cell (counting sort), so that a run of cells is a run of points */
+  std::partial_sum(cell_starts_.begin(), cell_starts_.end(), cell_starts_.begin());
+  {
+    std::vector<std::uint32_t> next(cell_starts_.begin(), cell_starts_.end() - 1);
+    std::vector<Point> sorted(points_.size());
+    for (std::size_t i = 0; i < points_.size(); ++i) {
+      sorted[next[cells[i]]++] = points_[i];
+    }
+    points_.swap(sorted);
+  }
+
+  /* prefix sums of occupied cells, per row */
+  for (int iy = 0; iy < size_; ++iy) {
+    std::uint32_t * sums = &row_sums_[static_cast<std::size_t>(iy) * (size_ + 1)];
+    const float * row = &distances_[static_cast<std::size_t>(iy) * size_];
+    sums[0] = 0;
+    for (int ix = 0; ix < size_; ++ix) {
+      sums[ix + 1] = sums[ix] + (row[ix] == 0.0f ? 1 : 0);
+    }
+  }
+
+  if (empty_) {
+    return true;
+  }
+
+  /* exact Euclidean distance transform: columns, then rows */
+  std::vector<float> f(size_);
+  std::vector<float> d(size_);
+  std::vector<int> v(size_);
+  std::vector<double> z(size_ + 1);
+
+  for (int ix = 0; ix < size_; ++ix) {
+    for (int iy = 0; iy < size_; ++iy) {
+      f[iy] = distances_[iy * size_ + ix];
+    }
+    transform1D(f.data(), d.data(), size_, v.data(), z.data());
+    for (int iy = 0; iy < size_; ++iy) {
+      distances_[iy * size_ + ix] = d[iy];
+    }
+  }
+
+  for (int iy = 0; iy < size_; ++iy) {
+    float * row = &distances_[static_cast<std::size_t>(iy) * size_];
+    std::copy(row, row + size_, f.begin());
+    transform1D(f.data(), row, size_, v.data(), z.data());
+  }
+
+  for (auto & d : distances_) {
+    d = std::sqrt(d) * static_cast<float>(resolution_);
+  }
+
+  return true;
+}
+
+double ScenarioAPIObstacleGrid::getCellDistance(const double x, const double y) const
+{
+  int ix, iy;
+  if (empty_ or not toCell(x, y, ix, iy)) {
+    return max_distance;
+  }
+  return distances_[iy * size_ + ix];
+}
+
+std::uint32_t ScenarioAPIObstacleGrid::countOccupied(const Polygon & poly) const
+{
+  const auto & ring = poly.outer();
+  if (ring.size() < 3) {
+    return 0;
+  }
+
+  bg::model::box<Point> box;
+  bg::envelope(poly, box);
+  const int first_row = std::max(
+    0, static_cast<int>(std::ceil((box.min_corner().y() - origin_) / resolution_ - 0.5)));
+  const int last_row = std::min(
+    size_ - 1, static_cast<int>(std::floor((box.max_corner().y() - origin_) / resolution_ - 0.5)));
+
+  std::uint32_t count = 0;
+  std::vector<double> crossings;
+
+  for (int iy = first_row; iy <= last_row; ++iy) {
+    const double yc = origin_ + (iy + 0.5) * resolution_;  // scanline through cell centers
+
+    crossings.clear();
+    for (std::size_t i = 0; i < ring.size(); ++i) {
+      const Point & a = ring[i];
+      const Point & b = ring[(i + 1) % ring.size()];
+      if ((a.y() <= yc) != (b.y() <= yc)) {
+        crossings.push_back(a.x() + (yc - a.y()) * (b.x() - a.x()) / (b.y() - a.y()));
+      }
+    }
+    std::sort(crossings.begin(), crossings.end());
+
+    const std::uint32_t * sums = &row_sums_[static_cast<std::size_t>(iy) * (size_ + 1)];
+    for (std::size_t i = 0; i + 1 < crossings.size(); i += 2) {
+      const int lo =
+        std::max(0, static_cast<int>(std::ceil((crossings[i] - origin_) / resolution_ - 0.5)));
+      const int hi = std::min(
+        size_ - 1, static_cast<int>(std::floor((crossings[i + 1] - origin_) / resolution_ - 0.5)));
+      if (lo <= hi) {
+        count += sums[hi + 1] - sums[lo];
+      }
+    }
+  }
+
+  return count;
+}
+
+double ScenarioAPIObstacleGrid::getUpperBound(const Polygon & poly) const
+{
+  if (empty_) {
+    return max_distance;
+  }
+
+  // a sample and a point are each within half a diagonal of the centers of their cells
+  const double margin = 2.0 * resolution_;
+
+  if (countOccupied(poly) > 0) {
+    return margin;
+  }
+
+  // no obstacle inside: the nearest one is nearest to the boundary
+  const auto & ring = poly.outer();
+  double minimum_distance = max_distance;
+  for (std::size_t i = 0; i < ring.size(); ++i) {
+    const Point & a = ring[i];
+    const Point & b = ring[(i + 1) % ring.size()];
+    const int n = std::max(1, static_cast<int>(std::ceil(bg::distance(a, b) / resolution_)));
+    for (int k = 0; k < n; ++k) {
+      const double t = static_cast<double>(k) / n;
+      minimum_distance = std::min(
+        minimum_distance,
+        getCellDistance(a.x() + t * (b.x() - a.x()), a.y() + t * (b.y() - a.y())));
+    }
+  }
+  return minimum_distance + margin;
+}
+
+double ScenarioAPIObstacleGrid::getDistance(const Polygon & poly) const
+{
+  if (!valid_) {
+    return 0.0;  // return short distance
+  }
+
+  double minimum_distance = max_distance;
+
+  const auto measure = [&](const Point * first, const Point * last) {
+    for (; first != last; ++first) {
+      minimum_distance = std::min(minimum_distance, bg::distance(*first, poly));
+    }
+  };
+
+  // every point nearer than the bound is inside the envelope widened by it
+  const double bound = getUpperBound(poly);
+  bg::model::box<Point> box;
+  bg::envelope(poly, box);
+  const double min_x = box.min_corner().x() - bound;
+  const double min_y = box.min_corner().y() - bound;
+  const double max_x = box.max_corner().x() + bound;
+  const double max_y = box.max_corner().y() + bound;
+
+  const double end = origin_ + size_ * resolution_;
+  if (min_x < origin_ or min_y < origin_ or end <= max_x or end <= max_y) {
+    measure(outside_.data(), outside_.data() + outside_.size());
+  }
+
+  if (empty_) {
+    return minimum_distance;
+  }
+
+  const auto clamp = [&](const double value) {
+    return static_cast<int>(std::max(0.0, std::min(size_ - 1.0, std::floor((value - origin_) / resolution_))));
+  };
+
+  const int first_column = clamp(min_x);
+  const int last_column = clamp(max_x);
+  for (int iy = clamp(min_y); iy <= clamp(max_y); ++iy) {
+    const std::uint32_t * starts = &cell_starts_[static_cast<std::size_t>(iy) * size_];
+    measure(points_.data() + starts[first_column], points_.data() + starts[last_column + 1]);
+  }
+
+  return minimum_distance;
+}
+
+double ScenarioAPIObstacleGrid::getDistanceInMap(const Polygon & poly) const
+{
+  Polygon local;
+  local.outer().reserve(poly.outer().size());
+  for (const auto & p : poly.outer()) {
+    local.outer().emplace_back(
+      map2grid_.transformX(p.x(), p.y()), map2grid_.transformY(p.x(), p.y()));
+  }
+  return getDistance(local);
+}
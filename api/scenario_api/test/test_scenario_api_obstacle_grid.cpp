@@ -0,0 +1,134 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The grid against the brute-force pass it replaced
+ * (calcDistFromPolygonToPointCloud), on random clouds that reach beyond the
+ * grid and random footprints in and around it.
+ */
+
+#include <scenario_api/scenario_api_obstacle_grid.h>
+#include <scenario_api/scenario_calc_dist_utils.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+namespace
+{
+constexpr double resolution = 0.2;  // [m]
+constexpr double range = 10.0;      // [m], half width of the grid
+constexpr double top = 2.0;         // [m]
+constexpr double bottom = 0.0;      // [m]
+
+std::shared_ptr<sensor_msgs::PointCloud2> makeCloud(
+  std::mt19937 & engine, const int count, const double extent)
+{
+  std::uniform_real_distribution<float> xy(-extent, extent);
+  std::uniform_real_distribution<float> z(-1.0f, 3.0f);
+
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  for (int i = 0; i < count; ++i) {
+    cloud.push_back(pcl::PointXYZ(xy(engine), xy(engine), z(engine)));
+  }
+
+  auto msg = std::make_shared<sensor_msgs::PointCloud2>();
+  pcl::toROSMsg(cloud, *msg);
+  msg->header.frame_id = "base_link";
+  return msg;
+}
+
+geometry_msgs::Pose makePose(std::mt19937 & engine, const double extent)
+{
+  std::uniform_real_distribution<double> xy(-extent, extent);
+  std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+  return poseFromValue(xy(engine), xy(engine), 0.0, yaw(engine));
+}
+
+// a rotated rectangle, as the footprints of the entities
+Polygon makeFootprint(std::mt19937 & engine, const double extent)
+{
+  std::uniform_real_distribution<double> length(0.1, 6.0);
+  geometry_msgs::Vector3 size;
+  size.x = length(engine);
+  size.y = length(engine);
+  return makeAbsolutePolygon(makePose(engine, extent), size);
+}
+}  // namespace
+
+TEST(ScenarioAPIObstacleGrid, MatchesBruteForce)
+{
+  std::mt19937 engine(42);
+  ScenarioAPIObstacleGrid grid(resolution, range);
+
+  for (const bool consider_height : {false, true}) {
+    for (const int count : {0, 1, 2, 500}) {
+      for (int trial = 0; trial < 10; ++trial) {
+        const auto cloud = makeCloud(engine, count, 1.5 * range);
+        ASSERT_TRUE(grid.build(cloud, geometry_msgs::Pose(), consider_height, top, bottom));
+
+        for (int query = 0; query < 50; ++query) {
+          const auto footprint = makeFootprint(engine, 2.0 * range);
+          EXPECT_NEAR(
+            grid.getDistance(footprint),
+            calcDistFromPolygonToPointCloud(cloud, footprint, consider_height, top, bottom), 1e-6)
+            << count << " points, trial " << trial << ", query " << query;
+        }
+      }
+    }
+  }
+}
+
+TEST(ScenarioAPIObstacleGrid, MeasuresFootprintsInMapFrame)
+{
+  std::mt19937 engine(7);
+  ScenarioAPIObstacleGrid grid(resolution, range);
+
+  for (int trial = 0; trial < 10; ++trial) {
+    const auto cloud = makeCloud(engine, 500, 1.5 * range);
+    const auto base_link_pose = makePose(engine, 100.0);
+    ASSERT_TRUE(grid.build(cloud, base_link_pose, false, top, bottom));
+
+    for (int query = 0; query < 50; ++query) {
+      const auto footprint = makeFootprint(engine, 2.0 * range);  // in base_link frame
+      EXPECT_NEAR(
+        grid.getDistanceInMap(transformPolygon(footprint, base_link_pose)),
+        calcDistFromPolygonToPointCloud(cloud, footprint, false, top, bottom), 1e-6);
+    }
+  }
+}
+
+TEST(ScenarioAPIObstacleGrid, ReturnsShortDistanceForUnusableCloud)
+{
+  ScenarioAPIObstacleGrid grid(resolution, range);
+
+  EXPECT_FALSE(grid.build(nullptr, geometry_msgs::Pose(), false, top, bottom));
+  EXPECT_EQ(grid.getDistance(Polygon()), 0.0);
+
+  std::mt19937 engine(0);
+  const auto cloud = makeCloud(engine, 10, range);
+  cloud->header.frame_id = "map";
+  EXPECT_FALSE(grid.build(cloud, geometry_msgs::Pose(), false, top, bottom));
+  EXPECT_EQ(grid.getDistance(makeFootprint(engine, range)), 0.0);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -41,6 +41,7 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <ros/ros.h>
 #include <scenario_api_utils/scenario_api_utils.h>
+#include <scenario_logger/clock.h>
 #include <sensor_msgs/Image.h>
 #include <sensor_msgs/PointCloud2.h>
 #include <std_msgs/Bool.h>
@@ -53,13 +54,17 @@
 #include <unistd.h>
 
 #include <boost/uuid/uuid_generators.hpp>
+#include <atomic>
 #include <chrono>
 #include <deque>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 /* define vehicle shape structure*/
@@ -80,6 +85,24 @@ struct Vehicle_Data
   double bottom_from_base() { return 0.0; };
 };
 
+/*
+ * Threading model
+ *
+ * Callbacks and timers may run on spinner threads concurrently with the API
+ * calls of the scenario runner, so the state is kept in three groups:
+ *
+ * - Messages from topics and the lanelet map are immutable snapshots. A
+ *   callback builds a new object and publishes it with std::atomic_store; a
+ *   reader takes its own reference with std::atomic_load once and works on
+ *   that, so that it never sees a half-updated value and keeps the snapshot
+ *   alive even if a newer one is published meanwhile.
+ * - Flags and counters written by callbacks are std::atomic, and the Autoware
+ *   state string is guarded by state_mutex_ (read it via getAutowareState).
+ * - Commands that mutate the traffic light state are serialized on
+ *   traffic_light_mutex_, which also guards the route and the light positions
+ *   read by the publishing timer. The timer copies the message under the lock
+ *   and publishes it after releasing the lock.
+ */
 class ScenarioAPIAutoware
 {
 public:
@@ -117,6 +140,7 @@ public:
   // basic self vehicle API
   Pose2D getCurrentPose();
   geometry_msgs::PoseStamped getCurrentPoseRos();
+  bool getPoseAt(const ros::Time & stamp, geometry_msgs::Pose & pose);  //!< @brief unchanged if unknown
   Polygon getSelfPolygon2D();
   double getVehicleTopFromBase();
   double getVehicleBottomFromBase();
@@ -145,6 +169,9 @@ public:
   bool isChangeLaneID();  // future work: // TODO
   bool getDistancefromCenterLine(double & dist_from_center_line);
   bool isInLane();
+  lanelet::LaneletMapPtr getLaneletMap() const;
+  lanelet::routing::RoutingGraphPtr getRoutingGraph() const;
+  bool getSpeedLimit(const lanelet::Id lane_id, double & speed_limit) const;  //!< @brief [m/s]
 
   // traffic light API
   /* use relation id which has the tag of regulatory_element type and "traffic_light" subtype */
@@ -190,35 +217,60 @@ private:
   const double fast_time_control_dt_ = 0.01;
   const double slow_time_control_dt_ = 0.2;
 
-  bool is_autoware_ready_initialize;
-  bool is_autoware_ready_routing;
-  std::string autoware_state_;
-  autoware_perception_msgs::TrafficLightStateArray traffic_light_state_;
-  double total_move_distance_;
-
-  // get msg from topic
+  //parameter for mission setup
+  double mission_setup_timeout_;         //!< @brief [s] give up a step after this
+  double mission_setup_retry_interval_;  //!< @brief [s] resend after this without any reaction
+  double start_velocity_timeout_;        //!< @brief [s] engage anyway after this
+  const double start_velocity_tolerance_ = 0.1;  //[m/s]
+  std::atomic<bool> start_velocity_pending_{false};  //!< @brief sent, not yet seen in the twist
+  std::atomic<double> start_velocity_{0.0};
+
+  std::atomic<bool> is_autoware_ready_initialize;
+  std::atomic<bool> is_autoware_ready_routing;
+  std::string autoware_state_;  //!< @brief guarded by state_mutex_
+  mutable std::mutex state_mutex_;
+  std::atomic<std::size_t> route_count_;  //!< @brief number of received routes (goal acknowledged)
+  autoware_perception_msgs::TrafficLightStateArray
+    traffic_light_state_;  //!< @brief guarded by traffic_light_mutex_
+  std::mutex traffic_light_mutex_;  //!< @brief serializes traffic light commands and publication
+  std::atomic<double> total_move_distance_;
+
+  // get msg from topic (snapshots, accessed via std::atomic_load/std::atomic_store)
+  struct TwistHistory
+  {
+    std::shared_ptr<geometry_msgs::TwistStamped> current;
+    std::shared_ptr<geometry_msgs::TwistStamped> previous;
+    std::shared_ptr<geometry_msgs::TwistStamped> second_previous;
+  };
   std::shared_ptr<sensor_msgs::PointCloud2> pcl_ptr_;
   std::shared_ptr<geometry_msgs::PoseStamped> current_pose_ptr_;
-  std::shared_ptr<geometry_msgs::PoseStamped> previous_pose_ptr_;
-  std::shared_ptr<geometry_msgs::TwistStamped> current_twist_ptr_;
-  std::shared_ptr<geometry_msgs::TwistStamped> previous_twist_ptr_;
-  std::shared_ptr<geometry_msgs::TwistStamped> second_previous_twist_ptr_;
+  std::shared_ptr<const TwistHistory> twist_history_ptr_;  //!< @brief published as a whole
   std::shared_ptr<autoware_vehicle_msgs::TurnSignal> turn_signal_ptr_;
   Vehicle_Data vehicle_data_;
 
-  // lanelet
+  // lanelet (snapshots, accessed via std::atomic_load/std::atomic_store)
   std::shared_ptr<lanelet::LaneletMap> lanelet_map_ptr_;
   std::shared_ptr<lanelet::routing::RoutingGraph> routing_graph_ptr_;
   std::shared_ptr<lanelet::traffic_rules::TrafficRules> traffic_rules_ptr_;
   std::shared_ptr<lanelet::Lanelet> closest_lanelet_ptr_;
+  std::shared_ptr<const std::unordered_map<lanelet::Id, double>>
+    speed_limits_ptr_;  //!< @brief lanelet id -> [m/s], precomputed at map load
 
   // TF
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_{tf_buffer_};
   tf2_ros::StaticTransformBroadcaster static_tf_broadcaster_;
 
-  // Traffic Light
+  // Traffic Light (mutable members below are guarded by traffic_light_mutex_)
   std::string camera_frame_id_;
+  bool traffic_light_relevance_filter_;     //!< @brief publish only lights near the ego or on route
+  double traffic_light_relevance_radius_;  //!< @brief [m]
+  std::unordered_map<lanelet::Id, geometry_msgs::Point>
+    traffic_light_positions_;  //!< @brief light (way id) -> position, precomputed at map load
+  std::vector<lanelet::Id> route_lane_ids_;                  //!< @brief lanelets of the current route
+  std::unordered_set<lanelet::Id> route_traffic_light_ids_;  //!< @brief lights governing the route
+  bool route_traffic_lights_outdated_;
+  autoware_perception_msgs::TrafficLightStateArray relevant_traffic_light_state_;
 
   //parameter for getMoveDistance
   const double valid_max_velocity_margin_ = 5.0;  //[m/s], 18kmph
@@ -238,8 +290,14 @@ private:
   void callbackTurnSignal(const autoware_vehicle_msgs::TurnSignal::ConstPtr & msg);
 
   // function for start API
+  std::string getAutowareState() const;
   bool checkState(const std::string state);
   bool waitState(const std::string state);
+  bool waitStartVelocity();
+  bool waitAcknowledgement(
+    const std::string & step, const std::function<bool()> & acknowledged,
+    const std::function<bool()> & lost = nullptr, const std::function<void()> & resend = nullptr,
+    double timeout = 0.0);  // [s], 0 for mission_setup_timeout_
 
   // function for basic self vehicle API
   double getAccel(
@@ -262,6 +320,8 @@ private:
     const lanelet::LaneletMapPtr & lanelet_map_ptr, double max_dist, double max_deleta_yaw);
   bool getCurrentLeftLaneID(
     int & current_left_id, const std::shared_ptr<lanelet::Lanelet> current_lane);
+  static std::shared_ptr<const std::unordered_map<lanelet::Id, double>> makeSpeedLimits(
+    const lanelet::LaneletMap & lanelet_map, const lanelet::traffic_rules::TrafficRules & traffic_rules);
   bool getDistancefromCenterLine(
     double & dist_from_center, const std::shared_ptr<geometry_msgs::PoseStamped> & current_pose,
     std::shared_ptr<lanelet::Lanelet> current_lanelet);
@@ -276,6 +336,10 @@ private:
 
   // function for Traffic Light API
   void pubTrafficLight();
+  void updateTrafficLightPositions(const lanelet::LaneletMap & lanelet_map);
+  void updateRouteTrafficLights(const lanelet::LaneletMap & lanelet_map);
+  bool isRelevantTrafficLight(
+    const lanelet::Id traffic_id, const geometry_msgs::PoseStamped & current_pose) const;
   uint8_t getTrafficLampStateFromString(const std::string & traffic_state);
   std::string getTrafficLampStringFromState(const uint8_t lamp_state);
   bool getTrafficLights(
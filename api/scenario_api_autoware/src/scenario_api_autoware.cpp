@@ -22,16 +22,25 @@ ScenarioAPIAutoware::ScenarioAPIAutoware()
   tf_listener_(tf_buffer_),
   is_autoware_ready_initialize(false),
   is_autoware_ready_routing(false),
-  total_move_distance_(0.0)
+  route_count_(0),
+  total_move_distance_(0.0),
+  route_traffic_lights_outdated_(false)
 {
   /* Get Parameter*/
   pnh_.param<std::string>("camera_frame_id", camera_frame_id_, "camera_link");
+  pnh_.param<bool>("traffic_light_relevance_filter", traffic_light_relevance_filter_, false);
+  pnh_.param<double>("traffic_light_relevance_radius", traffic_light_relevance_radius_, 200.0);
 
   //parameter for getMoveDistance
   pnh_.param<bool>("rosparam/add_simulator_noise", add_simulator_noise_, true);
   pnh_.param<double>("rosparam/simulator_pos_noise", simulator_noise_pos_dev_, 0.1);
   pnh_.param<double>("rosparam/max_velocity", autoware_max_velocity_, 30.0);
 
+  //parameter for mission setup
+  pnh_.param<double>("mission_setup_timeout", mission_setup_timeout_, 120.0);
+  pnh_.param<double>("mission_setup_retry_interval", mission_setup_retry_interval_, 2.0);
+  pnh_.param<double>("start_velocity_timeout", start_velocity_timeout_, 5.0);
+
   /* Scenario parameters*/
   vehicle_data_.wheel_radius = waitForParam<double>(pnh_, "/vehicle_info/wheel_radius");
   vehicle_data_.wheel_width = waitForParam<double>(pnh_, "/vehicle_info/wheel_width");
@@ -88,83 +97,110 @@ void ScenarioAPIAutoware::timerCallbackSlow(const ros::TimerEvent & te)
 
 void ScenarioAPIAutoware::callbackPointCloud(const sensor_msgs::PointCloud2::ConstPtr & msg)
 {
-  pcl_ptr_ = std::make_shared<sensor_msgs::PointCloud2>(*msg);
+  std::atomic_store(&pcl_ptr_, std::make_shared<sensor_msgs::PointCloud2>(*msg));
 }
 
 void ScenarioAPIAutoware::callbackMap(const autoware_lanelet2_msgs::MapBin & msg)
 {
   ROS_INFO("Start loading lanelet");
-  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
+  // build a new map aside and publish it when complete (readers may hold the previous one)
+  const auto lanelet_map_ptr = std::make_shared<lanelet::LaneletMap>();
+  decltype(traffic_rules_ptr_) traffic_rules_ptr;
+  decltype(routing_graph_ptr_) routing_graph_ptr;
   lanelet::utils::conversion::fromBinMsg(
-    msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+    msg, lanelet_map_ptr, &traffic_rules_ptr, &routing_graph_ptr);
+  {
+    std::lock_guard<std::mutex> lock(traffic_light_mutex_);
+    updateTrafficLightPositions(*lanelet_map_ptr);
+    route_traffic_lights_outdated_ = true;
+  }
+  std::atomic_store(&speed_limits_ptr_, makeSpeedLimits(*lanelet_map_ptr, *traffic_rules_ptr));
+  std::atomic_store(&traffic_rules_ptr_, traffic_rules_ptr);
+  std::atomic_store(&routing_graph_ptr_, routing_graph_ptr);
+  std::atomic_store(&lanelet_map_ptr_, lanelet_map_ptr);
   ROS_INFO("Map is loaded");
 }
 
 void ScenarioAPIAutoware::callbackRoute(const autoware_planning_msgs::Route & msg)
 {
+  {
+    std::lock_guard<std::mutex> lock(traffic_light_mutex_);
+    route_lane_ids_.clear();
+    for (const auto & section : msg.route_sections) {
+      route_lane_ids_.insert(
+        route_lane_ids_.end(), section.lane_ids.begin(), section.lane_ids.end());
+    }
+    route_traffic_lights_outdated_ = true;
+  }
+
   is_autoware_ready_routing = true;  // check autoware rady
+  ++route_count_;
 }
 
 void ScenarioAPIAutoware::callbackStatus(const autoware_system_msgs::AutowareState & msg)
 {
-  autoware_state_ = msg.state;
-  if (autoware_state_ != autoware_system_msgs::AutowareState::Emergency)
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    autoware_state_ = msg.state;
+  }
+  if (msg.state != autoware_system_msgs::AutowareState::Emergency)
     is_autoware_ready_initialize = true;
 }
 
 void ScenarioAPIAutoware::callbackTwist(const geometry_msgs::TwistStamped::ConstPtr & msg)
 {
-  if (previous_twist_ptr_ != nullptr) {
-    second_previous_twist_ptr_ =
-      std::make_shared<geometry_msgs::TwistStamped>(*previous_twist_ptr_);
-  }
-
-  if (current_twist_ptr_ != nullptr) {
-    previous_twist_ptr_ = std::make_shared<geometry_msgs::TwistStamped>(*current_twist_ptr_);
-  }
-  current_twist_ptr_ = std::make_shared<geometry_msgs::TwistStamped>(*msg);
+  // shift the history in a new snapshot, so that readers always see three consecutive twists
+  const auto previous_history = std::atomic_load(&twist_history_ptr_);
+  auto history = std::make_shared<TwistHistory>();
+  if (previous_history) {
+    history->second_previous = previous_history->previous;
+    history->previous = previous_history->current;
+  }
+  history->current = std::make_shared<geometry_msgs::TwistStamped>(*msg);
+  std::atomic_store(&twist_history_ptr_, std::shared_ptr<const TwistHistory>(history));
 }
 
 void ScenarioAPIAutoware::callbackTurnSignal(
   const autoware_vehicle_msgs::TurnSignal::ConstPtr & msg)
 {
-  turn_signal_ptr_ = std::make_shared<autoware_vehicle_msgs::TurnSignal>(*msg);
+  std::atomic_store(&turn_signal_ptr_, std::make_shared<autoware_vehicle_msgs::TurnSignal>(*msg));
 }
 
 // basic API
 bool ScenarioAPIAutoware::isAPIReady()
 {
-  if (current_pose_ptr_ == nullptr) {
+  if (std::atomic_load(&current_pose_ptr_) == nullptr) {
     ROS_WARN_DELAYED_THROTTLE(5.0, "current_pose is nullptr");
     return false;
   }
 
-  if (pcl_ptr_ == nullptr) {
+  if (std::atomic_load(&pcl_ptr_) == nullptr) {
     ROS_WARN_DELAYED_THROTTLE(5.0, "pointcloud is nullptr");
     return false;
   }
 
-  if (lanelet_map_ptr_ == nullptr) {
+  if (std::atomic_load(&lanelet_map_ptr_) == nullptr) {
     ROS_WARN_DELAYED_THROTTLE(5.0, "lanelet_map is nullptr");
     return false;
   }
 
-  if (current_twist_ptr_ == nullptr) {
+  const auto twist_history = std::atomic_load(&twist_history_ptr_);
+  if (twist_history == nullptr or twist_history->current == nullptr) {
     ROS_WARN_DELAYED_THROTTLE(5.0, "current_twist is nullptr");
     return false;
   }
 
-  if (previous_twist_ptr_ == nullptr) {
+  if (twist_history->previous == nullptr) {
     ROS_WARN_DELAYED_THROTTLE(5.0, "previous_twist is nullptr");
     return false;
   }
 
-  if (second_previous_twist_ptr_ == nullptr) {
+  if (twist_history->second_previous == nullptr) {
     ROS_WARN_DELAYED_THROTTLE(5.0, "second_previous_twist is nullptr");
     return false;
   }
 
-  if (turn_signal_ptr_ == nullptr) {
+  if (std::atomic_load(&turn_signal_ptr_) == nullptr) {
     ROS_WARN_DELAYED_THROTTLE(5.0, "turn_signal is nullptr");
     return false;
   }
@@ -203,27 +239,23 @@ bool ScenarioAPIAutoware::sendStartPoint(
   }
 
   pub_start_point_.publish(posewcs);
-
-  //publish recurssively until self-pose tf is published
-  while (!current_pose_ptr_) {
-    ros::Rate(2.0).sleep();
-    pub_start_point_.publish(posewcs);
-    ros::spinOnce();
-  }
-
-  if (wait_autoware_status) {
-    //publish recurssively until state changes
-    while (!checkState(autoware_system_msgs::AutowareState::WaitingForRoute)) {
-      ros::Rate(2.0).sleep();
+  const std::string state_at_publication = getAutowareState();
+
+  // wait for localization (self-pose tf) and, if requested, for route waiting state
+  return waitAcknowledgement(
+    "start point",
+    [&]() {
+      return std::atomic_load(&current_pose_ptr_) and
+             (!wait_autoware_status ||
+              getAutowareState() == autoware_system_msgs::AutowareState::WaitingForRoute);
+    },
+    [&]() {
+      return !std::atomic_load(&current_pose_ptr_) or getAutowareState() == state_at_publication;
+    },
+    [&]() {
       posewcs.header.stamp = ros::Time::now();
       pub_start_point_.publish(posewcs);
-      ros::spinOnce();
-    }
-  }
-  //In some cases, goalpoint is send soon after startpoint, mission planner cannot plan route.
-  sleep(1.0);  //TODO remove this
-
-  return true;  // TODO check success(add timeout function)
+    });
 }
 
 bool ScenarioAPIAutoware::sendGoalPoint(
@@ -244,22 +276,24 @@ bool ScenarioAPIAutoware::sendGoalPoint(
   }
 
   pub_goal_point_.publish(posestmp);
+  const std::size_t route_count_at_publication = route_count_;
 
-  if (wait_autoware_status) {
-    //publish recurssively until state changes
-    while (!checkState(autoware_system_msgs::AutowareState::WaitingForEngage)) {
-      ros::Rate(1.0).sleep();
-      posestmp.header.stamp = ros::Time::now();
-      pub_goal_point_.publish(posestmp);
-      ros::spinOnce();
-    }
+  if (!wait_autoware_status) {
+    return true;
   }
-  //sleep for initial velocity start
-  //if there are no sleep from sendgoal to engage,
-  //ego vehicle decelerates soon after start
-  ros::Rate(1.0).sleep();
 
-  return true;  // TODO check success(add timeout function)
+  // the route is the acknowledgement of the goal; planning may take a while after that
+  return waitAcknowledgement(
+    "goal point",
+    [&]() {
+      return route_count_ > route_count_at_publication and
+             getAutowareState() == autoware_system_msgs::AutowareState::WaitingForEngage;
+    },
+    [&]() { return route_count_ == route_count_at_publication; },
+    [&]() {
+      posestmp.header.stamp = ros::Time::now();
+      pub_goal_point_.publish(posestmp);
+    });
 }
 
 bool ScenarioAPIAutoware::sendCheckPoint(
@@ -280,30 +314,80 @@ bool ScenarioAPIAutoware::sendCheckPoint(
   }
 
   pub_check_point_.publish(posestmp);
-  if (wait_autoware_status) {
-    // wait for message-received and planning
-    waitState(autoware_system_msgs::AutowareState::WaitingForEngage);
+  if (!wait_autoware_status) {
+    return true;
   }
-  return true;  // TODO check success(add timeout function)
+
+  // wait for message-received and planning
+  // (never resent: mission planner would take a duplicated check point as another one)
+  return waitAcknowledgement("check point", [&]() {
+    return getAutowareState() == autoware_system_msgs::AutowareState::WaitingForEngage;
+  });
+}
+
+std::string ScenarioAPIAutoware::getAutowareState() const
+{
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  return autoware_state_;
 }
 
 bool ScenarioAPIAutoware::checkState(const std::string state)
 {
-  ROS_INFO_STREAM("autoware_state:" << autoware_state_ << ", target_state" << state << std::endl);
-  return autoware_state_ == state;
+  const std::string autoware_state = getAutowareState();
+  ROS_INFO_STREAM("autoware_state:" << autoware_state << ", target_state" << state << std::endl);
+  return autoware_state == state;
 }
 
 bool ScenarioAPIAutoware::waitState(const std::string state)
 {
   // wait for state change
+  return waitAcknowledgement("state " + state, [&]() { return getAutowareState() == state; });
+}
+
+bool ScenarioAPIAutoware::waitAcknowledgement(
+  const std::string & step, const std::function<bool()> & acknowledged,
+  const std::function<bool()> & lost, const std::function<void()> & resend, double timeout)
+{
+  if (timeout <= 0.0) {
+    timeout = mission_setup_timeout_;
+  }
+
+  const ros::WallTime start = ros::WallTime::now();
+  ros::WallTime last_sent = start;
+  int resend_count = 0;
+
+  ros::WallRate rate(100.0);
   while (ros::ok()) {
-    if (autoware_state_ == state) {
-      break;
-    }
-    ros::Rate(10.0).sleep();
     ros::spinOnce();
+
+    const ros::WallTime now = ros::WallTime::now();
+    if (acknowledged()) {
+      ROS_INFO(
+        "mission setup: %s acknowledged in %.3f [s] (resent %d times)", step.c_str(),
+        (now - start).toSec(), resend_count);
+      return true;
+    }
+
+    if ((now - start).toSec() > timeout) {
+      ROS_ERROR(
+        "mission setup: %s timed out after %.3f [s] (autoware_state: %s)", step.c_str(),
+        (now - start).toSec(), getAutowareState().c_str());
+      return false;
+    }
+
+    // resend only if nothing reacted to the last message
+    if (resend and (now - last_sent).toSec() > mission_setup_retry_interval_) {
+      if (lost and lost()) {
+        ROS_WARN("mission setup: %s seems to be lost, resend", step.c_str());
+        resend();
+        ++resend_count;
+      }
+      last_sent = now;
+    }
+
+    rate.sleep();
   }
-  return true;  // TODO: set timeout
+  return false;
 }
 
 bool ScenarioAPIAutoware::sendStartVelocity(const double velocity)
@@ -313,11 +397,39 @@ bool ScenarioAPIAutoware::sendStartVelocity(const double velocity)
   twistmsg.header.stamp = ros::Time::now();
   twistmsg.twist.linear.x = velocity;
   pub_start_velocity_.publish(twistmsg);
-  return true;  // TODO check success
+
+  // the topic is latched and the simulator applies it with the next start point,
+  // so nothing can be observed yet: it is waited for on engage (see waitStartVelocity)
+  start_velocity_ = velocity;
+  start_velocity_pending_ = true;
+  return true;
+}
+
+bool ScenarioAPIAutoware::waitStartVelocity()
+{
+  // if engaged before the ego runs at its start velocity, the ego decelerates after engage
+  if (!start_velocity_pending_.exchange(false)) {
+    return true;
+  }
+
+  const double velocity = start_velocity_;
+  return waitAcknowledgement(
+    "start velocity",
+    [&]() {
+      const auto twist_history = std::atomic_load(&twist_history_ptr_);
+      return twist_history and twist_history->current and
+             std::abs(twist_history->current->twist.linear.x - velocity) <=
+               start_velocity_tolerance_;
+    },
+    nullptr, nullptr, start_velocity_timeout_);
 }
 
 bool ScenarioAPIAutoware::sendEngage(const bool engage)
 {
+  if (engage and !waitStartVelocity()) {
+    ROS_WARN("engage without the ego running at its start velocity");
+  }
+
   std_msgs::Bool boolmsg;
   boolmsg.data = engage;
   pub_autoware_engage_.publish(boolmsg);
@@ -368,19 +480,40 @@ void ScenarioAPIAutoware::getCurrentPoseFromTF(void)
   ps.pose.position.y = transform.transform.translation.y;
   ps.pose.position.z = transform.transform.translation.z;
   ps.pose.orientation = transform.transform.rotation;
-  current_pose_ptr_ = std::make_shared<geometry_msgs::PoseStamped>(ps);
+  std::atomic_store(&current_pose_ptr_, std::make_shared<geometry_msgs::PoseStamped>(ps));
+}
+
+bool ScenarioAPIAutoware::getPoseAt(const ros::Time & stamp, geometry_msgs::Pose & pose)
+{
+  geometry_msgs::TransformStamped transform;
+  try {
+    transform = tf_buffer_.lookupTransform("map", "base_link", stamp);
+  } catch (tf2::TransformException & ex) {
+    ROS_WARN_DELAYED_THROTTLE(5.0, "cannot get map to base_link transform at %f. %s", stamp.toSec(), ex.what());
+    return false;
+  }
+
+  pose.position.x = transform.transform.translation.x;
+  pose.position.y = transform.transform.translation.y;
+  pose.position.z = transform.transform.translation.z;
+  pose.orientation = transform.transform.rotation;
+  return true;
 }
 
 Pose2D ScenarioAPIAutoware::getCurrentPose()
 {
+  const auto current_pose = std::atomic_load(&current_pose_ptr_);
   Pose2D p;
-  p.x = current_pose_ptr_->pose.position.x;
-  p.y = current_pose_ptr_->pose.position.y;
-  p.yaw = tf2::getYaw(current_pose_ptr_->pose.orientation);
+  p.x = current_pose->pose.position.x;
+  p.y = current_pose->pose.position.y;
+  p.yaw = yawFromQuat(current_pose->pose.orientation);
   return p;
 }
 
-geometry_msgs::PoseStamped ScenarioAPIAutoware::getCurrentPoseRos() { return *current_pose_ptr_; }
+geometry_msgs::PoseStamped ScenarioAPIAutoware::getCurrentPoseRos()
+{
+  return *std::atomic_load(&current_pose_ptr_);
+}
 
 Polygon ScenarioAPIAutoware::getSelfPolygon2D() { return getSelfPolygon2D(vehicle_data_); }
 
@@ -388,13 +521,22 @@ double ScenarioAPIAutoware::getVehicleTopFromBase() { return vehicle_data_.top_f
 
 double ScenarioAPIAutoware::getVehicleBottomFromBase() { return vehicle_data_.bottom_from_base(); }
 
-double ScenarioAPIAutoware::getVelocity() { return current_twist_ptr_->twist.linear.x; }
+double ScenarioAPIAutoware::getVelocity()
+{
+  return std::atomic_load(&twist_history_ptr_)->current->twist.linear.x;
+}
 
-double ScenarioAPIAutoware::getAccel() { return getAccel(current_twist_ptr_, previous_twist_ptr_); }
+double ScenarioAPIAutoware::getAccel()
+{
+  const auto twist_history = std::atomic_load(&twist_history_ptr_);
+  return getAccel(twist_history->current, twist_history->previous);
+}
 
 double ScenarioAPIAutoware::getJerk()
 {
-  return getJerk(current_twist_ptr_, previous_twist_ptr_, second_previous_twist_ptr_);
+  const auto twist_history = std::atomic_load(&twist_history_ptr_);
+  return getJerk(
+    twist_history->current, twist_history->previous, twist_history->second_previous);
 }
 
 double ScenarioAPIAutoware::getMoveDistance() { return total_move_distance_; }
@@ -441,40 +583,42 @@ void ScenarioAPIAutoware::updateTotalMoveDistance()
   const static double valid_min_velocity_thresh_ =
     add_simulator_noise_ * (3 * std::sqrt(2) * simulator_noise_pos_dev_) / slow_time_control_dt_;
 
-  if (!current_pose_ptr_) {
+  const auto current_pose_ptr = std::atomic_load(&current_pose_ptr_);
+  if (!current_pose_ptr) {
     return;
   }
 
-  static auto previous_pose_ptr_ = *current_pose_ptr_;
+  static auto previous_pose_ptr_ = *current_pose_ptr;
 
   //calculate delta-distance
   const double dt =
-    current_pose_ptr_->header.stamp.toSec() - previous_pose_ptr_.header.stamp.toSec();
-  const double dx = current_pose_ptr_->pose.position.x - previous_pose_ptr_.pose.position.x;
-  const double dy = current_pose_ptr_->pose.position.y - previous_pose_ptr_.pose.position.y;
+    current_pose_ptr->header.stamp.toSec() - previous_pose_ptr_.header.stamp.toSec();
+  const double dx = current_pose_ptr->pose.position.x - previous_pose_ptr_.pose.position.x;
+  const double dy = current_pose_ptr->pose.position.y - previous_pose_ptr_.pose.position.y;
   const double dist = std::hypot(dx, dy);  //do not consider height
   const double v = dist / dt;
 
   // check invalid move
   if (std::isnan(v)) {
-    previous_pose_ptr_ = *current_pose_ptr_;
+    previous_pose_ptr_ = *current_pose_ptr;
     return;
   }
   if (std::fabs(v) > valid_max_velocity_thresh_) {
     ROS_ERROR_STREAM(
       "Detect invalid movement. Do not add delta-pose to total-move-distance. v=( " << v << " )");
-    previous_pose_ptr_ = *current_pose_ptr_;
+    previous_pose_ptr_ = *current_pose_ptr;
     return;
   }
 
   //avoid to add distance by simulator-noise to total move distance
   if (std::fabs(v) < valid_min_velocity_thresh_) {
-    previous_pose_ptr_ = *current_pose_ptr_;
+    previous_pose_ptr_ = *current_pose_ptr;
     return;
   }
 
-  total_move_distance_ += dist;
-  previous_pose_ptr_ = *current_pose_ptr_;
+  // NOTE: only this timer writes the distance, so load and store need not be one atomic step
+  total_move_distance_ = total_move_distance_ + dist;
+  previous_pose_ptr_ = *current_pose_ptr;
 }
 
 bool ScenarioAPIAutoware::shiftEgoPose(
@@ -525,9 +669,15 @@ bool ScenarioAPIAutoware::getRightBlinker(
   return (turn_signal_ptr->data == autoware_vehicle_msgs::TurnSignal::RIGHT);
 }
 
-bool ScenarioAPIAutoware::getLeftBlinker() { return getLeftBlinker(turn_signal_ptr_); }
+bool ScenarioAPIAutoware::getLeftBlinker()
+{
+  return getLeftBlinker(std::atomic_load(&turn_signal_ptr_));
+}
 
-bool ScenarioAPIAutoware::getRightBlinker() { return getRightBlinker(turn_signal_ptr_); }
+bool ScenarioAPIAutoware::getRightBlinker()
+{
+  return getRightBlinker(std::atomic_load(&turn_signal_ptr_));
+}
 
 bool ScenarioAPIAutoware::approveLaneChange(bool approve_lane_change)
 {
@@ -538,12 +688,17 @@ bool ScenarioAPIAutoware::approveLaneChange(bool approve_lane_change)
 }
 
 // sensor API
-std::shared_ptr<sensor_msgs::PointCloud2> ScenarioAPIAutoware::getPointCloud() { return pcl_ptr_; }
+std::shared_ptr<sensor_msgs::PointCloud2> ScenarioAPIAutoware::getPointCloud()
+{
+  return std::atomic_load(&pcl_ptr_);
+}
 
 // lane API
 bool ScenarioAPIAutoware::getCurrentLaneID(int & current_id, double max_dist, double max_delta_yaw)
 {
-  return getCurrentLaneID(current_id, current_pose_ptr_, lanelet_map_ptr_, max_dist, max_delta_yaw);
+  return getCurrentLaneID(
+    current_id, std::atomic_load(&current_pose_ptr_), std::atomic_load(&lanelet_map_ptr_),
+    max_dist, max_delta_yaw);
 }
 
 bool ScenarioAPIAutoware::getCurrentLaneID(
@@ -557,8 +712,8 @@ bool ScenarioAPIAutoware::getCurrentLaneID(
   lanelet::Lanelet target_closest_lanelet;
   bool is_found_target_closest_lanelet = false;
   double min_dist = max_dist;
+  const double current_yaw = yawFromQuat(current_pose->pose.orientation);
   for (const auto & lanelet : nearest_lanelets) {
-    double current_yaw = tf2::getYaw(current_pose->pose.orientation);
     double lane_yaw = lanelet::utils::getLaneletAngle(lanelet.second, current_pose->pose.position);
     double delta_yaw = std::abs(normalizeRadian(current_yaw - lane_yaw));
     if (lanelet.first < max_dist && delta_yaw < max_delta_yaw and lanelet.first < min_dist) {
@@ -569,7 +724,8 @@ bool ScenarioAPIAutoware::getCurrentLaneID(
   }
 
   if (is_found_target_closest_lanelet) {
-    closest_lanelet_ptr_ = std::make_shared<lanelet::Lanelet>(target_closest_lanelet);
+    std::atomic_store(
+      &closest_lanelet_ptr_, std::make_shared<lanelet::Lanelet>(target_closest_lanelet));
     current_id = (int)target_closest_lanelet.id();
     return true;
   } else {
@@ -586,7 +742,7 @@ bool ScenarioAPIAutoware::getCurrentLeftLaneID(
     return false;
   }
 
-  auto left_lane = routing_graph_ptr_->left(*current_lane);
+  auto left_lane = std::atomic_load(&routing_graph_ptr_)->left(*current_lane);
   if (!left_lane) {
     // current lane has not left lane
     return false;
@@ -595,6 +751,42 @@ bool ScenarioAPIAutoware::getCurrentLeftLaneID(
   return true;
 }
 
+lanelet::LaneletMapPtr ScenarioAPIAutoware::getLaneletMap() const
+{
+  return std::atomic_load(&lanelet_map_ptr_);
+}
+
+lanelet::routing::RoutingGraphPtr ScenarioAPIAutoware::getRoutingGraph() const
+{
+  return std::atomic_load(&routing_graph_ptr_);
+}
+
+bool ScenarioAPIAutoware::getSpeedLimit(const lanelet::Id lane_id, double & speed_limit) const
+{
+  const auto speed_limits = std::atomic_load(&speed_limits_ptr_);
+  if (speed_limits == nullptr) {
+    return false;
+  }
+  const auto iter = speed_limits->find(lane_id);
+  if (iter == speed_limits->end()) {
+    return false;
+  }
+  speed_limit = iter->second;
+  return true;
+}
+
+std::shared_ptr<const std::unordered_map<lanelet::Id, double>> ScenarioAPIAutoware::makeSpeedLimits(
+  const lanelet::LaneletMap & lanelet_map, const lanelet::traffic_rules::TrafficRules & traffic_rules)
+{
+  // traffic_rules.speedLimit resolves regulatory elements and attributes on every call
+  const auto speed_limits = std::make_shared<std::unordered_map<lanelet::Id, double>>();
+  speed_limits->reserve(lanelet_map.laneletLayer.size());
+  for (const auto & lanelet : lanelet_map.laneletLayer) {
+    speed_limits->emplace(lanelet.id(), traffic_rules.speedLimit(lanelet).speedLimit.value());
+  }
+  return speed_limits;
+}
+
 bool ScenarioAPIAutoware::isChangeLaneID()
 {
   ROS_WARN("isChangeLaneID is not implemented yet.");
@@ -604,7 +796,9 @@ bool ScenarioAPIAutoware::isChangeLaneID()
 
 bool ScenarioAPIAutoware::getDistancefromCenterLine(double & dist_from_center_line)
 {
-  return getDistancefromCenterLine(dist_from_center_line, current_pose_ptr_, closest_lanelet_ptr_);
+  return getDistancefromCenterLine(
+    dist_from_center_line, std::atomic_load(&current_pose_ptr_),
+    std::atomic_load(&closest_lanelet_ptr_));
 }
 
 bool ScenarioAPIAutoware::getDistancefromCenterLine(
@@ -652,7 +846,10 @@ bool ScenarioAPIAutoware::isInLane(
   return (bg::distance(poly, point2d) <= 0);
 }
 
-bool ScenarioAPIAutoware::isInLane() { return isInLane(current_pose_ptr_, closest_lanelet_ptr_); }
+bool ScenarioAPIAutoware::isInLane()
+{
+  return isInLane(std::atomic_load(&current_pose_ptr_), std::atomic_load(&closest_lanelet_ptr_));
+}
 
 // traffic light API
 
@@ -703,6 +900,7 @@ bool ScenarioAPIAutoware::setTrafficLightsColor(
     return false;
   }
 
+  std::lock_guard<std::mutex> lock(traffic_light_mutex_);
   for (const auto traffic_light : traffic_lights) {
     if (!setTrafficLightColor(traffic_light.id(), traffic_color)) {
       return false;
@@ -753,6 +951,7 @@ bool ScenarioAPIAutoware::setTrafficLightsArrow(
     return false;
   }
 
+  std::lock_guard<std::mutex> lock(traffic_light_mutex_);
   for (const auto traffic_light : traffic_lights) {
     if (!setTrafficLightArrow(traffic_light.id(), traffic_arrow)) {
       return false;
@@ -793,6 +992,7 @@ bool ScenarioAPIAutoware::resetTrafficLightsColor(const int traffic_relation_id)
       return false;
     }
 
+    std::lock_guard<std::mutex> lock(traffic_light_mutex_);
     for (const auto traffic_light : traffic_lights) {
       if (!resetTrafficLightColor(traffic_light.id())) {
         return false;
@@ -841,6 +1041,7 @@ bool ScenarioAPIAutoware::resetTrafficLightsArrow(const int traffic_relation_id)
       return false;
     }
 
+    std::lock_guard<std::mutex> lock(traffic_light_mutex_);
     for (const auto traffic_light : traffic_lights) {
       if (!resetTrafficLightArrow(traffic_light.id())) {
         return false;
@@ -859,6 +1060,7 @@ bool ScenarioAPIAutoware::getTrafficLightColor(
       "traffic light id:" << traffic_relation_id << " is invalid. cannot get traffic light");
     return false;
   }
+  std::lock_guard<std::mutex> lock(traffic_light_mutex_);
   for (const auto & traffic_light : traffic_lights) {
     for (const auto & tl_state : traffic_light_state_.states) {
       if (traffic_light.id() == tl_state.id) {
@@ -892,6 +1094,7 @@ bool ScenarioAPIAutoware::getTrafficLightArrow(
     return false;
   }
   traffic_arrow->clear();
+  std::lock_guard<std::mutex> lock(traffic_light_mutex_);
   for (const auto traffic_light : traffic_lights) {
     for (const auto tl_state : traffic_light_state_.states) {
       if (traffic_light.id() == tl_state.id) {
@@ -935,13 +1138,14 @@ std::vector<geometry_msgs::Point> ScenarioAPIAutoware::getTrafficLightPosition(
 bool ScenarioAPIAutoware::getTrafficLineCenterPosition(
   const int traffic_relation_id, geometry_msgs::Point & line_center)
 {
-  if (!lanelet_map_ptr_->regulatoryElementLayer.exists(traffic_relation_id)) {
+  const auto lanelet_map_ptr = std::atomic_load(&lanelet_map_ptr_);
+  if (!lanelet_map_ptr->regulatoryElementLayer.exists(traffic_relation_id)) {
     ROS_WARN_STREAM(
       "RegulatoryElement, id:" << traffic_relation_id << "does not exist. Check the traffic id");
     return false;
   }
 
-  auto traffic_element = lanelet_map_ptr_->regulatoryElementLayer.get(traffic_relation_id);
+  auto traffic_element = lanelet_map_ptr->regulatoryElementLayer.get(traffic_relation_id);
 
   auto traffic_light_reg_elem = std::dynamic_pointer_cast<lanelet::TrafficLight>(traffic_element);
   if (!traffic_light_reg_elem) {
@@ -981,8 +1185,8 @@ bool ScenarioAPIAutoware::getTrafficLineCenterPose(
   }
 
   lanelet::BasicPoint2d search_point(stop_line_center.position.x, stop_line_center.position.y);
-  const auto nearest_lanelet =
-    lanelet::geometry::findNearest(lanelet_map_ptr_->laneletLayer, search_point, 1);
+  const auto nearest_lanelet = lanelet::geometry::findNearest(
+    std::atomic_load(&lanelet_map_ptr_)->laneletLayer, search_point, 1);
 
   //get stop line orientation(input orientation of nearest lane)
   if (nearest_lanelet.empty()) {
@@ -1057,10 +1261,10 @@ bool ScenarioAPIAutoware::checkOverTrafficLine(
 
   const double dx = self_pose.position.x - line_center.position.x;
   const double dy = self_pose.position.y - line_center.position.y;
-  const double lane2self_yaw = std::atan2(dy, dx);
-  const double lane_yaw = yawFromQuat(line_center.orientation);
+  const SE2 line = SE2::fromPose(line_center);
 
-  if (std::fabs(normalizeRadian(lane_yaw - lane2self_yaw)) <= M_PI / 2.0) {
+  // angle between lane direction and line-to-self direction is within +-90 [deg]
+  if (line.c * dx + line.s * dy >= 0.0) {
     //base link is over the line
     over_line = true;
     return true;
@@ -1078,12 +1282,13 @@ bool ScenarioAPIAutoware::checkOverTrafficLine(
 bool ScenarioAPIAutoware::getTrafficLights(
   const int traffic_relation_id, lanelet::LineStringsOrPolygons3d & traffic_lights)
 {
-  if (!lanelet_map_ptr_->regulatoryElementLayer.exists(traffic_relation_id)) {
+  const auto lanelet_map_ptr = std::atomic_load(&lanelet_map_ptr_);
+  if (!lanelet_map_ptr->regulatoryElementLayer.exists(traffic_relation_id)) {
     ROS_WARN_STREAM(
       "regulatoryElement, id:" << traffic_relation_id << "does not exist. Check the traffic id");
     return false;
   }
-  auto traffic_element = lanelet_map_ptr_->regulatoryElementLayer.get(traffic_relation_id);
+  auto traffic_element = lanelet_map_ptr->regulatoryElementLayer.get(traffic_relation_id);
 
   auto traffic_light_reg_elem = std::dynamic_pointer_cast<lanelet::TrafficLight>(traffic_element);
   if (!traffic_light_reg_elem) {
@@ -1152,9 +1357,92 @@ std::string ScenarioAPIAutoware::getTrafficLampStringFromState(const uint8_t lam
 
 void ScenarioAPIAutoware::pubTrafficLight()
 {
+  const auto current_pose_ptr = std::atomic_load(&current_pose_ptr_);
+  const auto lanelet_map_ptr = std::atomic_load(&lanelet_map_ptr_);
+
+  // take a copy under the lock and publish it without holding the lock
+  std::unique_lock<std::mutex> lock(traffic_light_mutex_);
   traffic_light_state_.header.frame_id = camera_frame_id_;
-  traffic_light_state_.header.stamp = ros::Time::now();
-  pub_traffic_detection_result_.publish(traffic_light_state_);
+  traffic_light_state_.header.stamp = scenario_logger::now();
+
+  if (!traffic_light_relevance_filter_ or current_pose_ptr == nullptr) {
+    const auto traffic_light_state = traffic_light_state_;
+    lock.unlock();
+    pub_traffic_detection_result_.publish(traffic_light_state);
+    return;
+  }
+
+  if (route_traffic_lights_outdated_ and lanelet_map_ptr != nullptr) {
+    updateRouteTrafficLights(*lanelet_map_ptr);
+  }
+
+  relevant_traffic_light_state_.header = traffic_light_state_.header;
+  relevant_traffic_light_state_.states.clear();
+  for (const auto & tl_state : traffic_light_state_.states) {
+    if (isRelevantTrafficLight(tl_state.id, *current_pose_ptr)) {
+      relevant_traffic_light_state_.states.emplace_back(tl_state);
+    }
+  }
+  const auto relevant_traffic_light_state = relevant_traffic_light_state_;
+  lock.unlock();
+  pub_traffic_detection_result_.publish(relevant_traffic_light_state);
+}
+
+void ScenarioAPIAutoware::updateTrafficLightPositions(const lanelet::LaneletMap & lanelet_map)
+{
+  traffic_light_positions_.clear();
+  for (const auto & reg_elem : lanelet_map.regulatoryElementLayer) {
+    const auto traffic_light_reg_elem = std::dynamic_pointer_cast<lanelet::TrafficLight>(reg_elem);
+    if (!traffic_light_reg_elem) {
+      continue;
+    }
+    for (const auto & traffic_light : traffic_light_reg_elem->trafficLights()) {
+      const auto tl = traffic_light.lineString();
+      if (!tl or tl->empty()) {
+        continue;
+      }
+      // center of the light
+      geometry_msgs::Point tl_point;
+      tl_point.x = (tl->front().x() + tl->back().x()) / 2.0;
+      tl_point.y = (tl->front().y() + tl->back().y()) / 2.0;
+      tl_point.z = (tl->front().z() + tl->back().z()) / 2.0;
+      traffic_light_positions_[traffic_light.id()] = tl_point;
+    }
+  }
+}
+
+void ScenarioAPIAutoware::updateRouteTrafficLights(const lanelet::LaneletMap & lanelet_map)
+{
+  route_traffic_light_ids_.clear();
+  for (const auto & lane_id : route_lane_ids_) {
+    if (!lanelet_map.laneletLayer.exists(lane_id)) {
+      continue;
+    }
+    const auto lanelet = lanelet_map.laneletLayer.get(lane_id);
+    for (const auto & reg_elem : lanelet.regulatoryElementsAs<const lanelet::TrafficLight>()) {
+      for (const auto & traffic_light : reg_elem->trafficLights()) {
+        route_traffic_light_ids_.insert(traffic_light.id());
+      }
+    }
+  }
+  route_traffic_lights_outdated_ = false;
+}
+
+bool ScenarioAPIAutoware::isRelevantTrafficLight(
+  const lanelet::Id traffic_id, const geometry_msgs::PoseStamped & current_pose) const
+{
+  if (route_traffic_light_ids_.count(traffic_id) > 0) {
+    return true;
+  }
+
+  const auto position = traffic_light_positions_.find(traffic_id);
+  if (position == traffic_light_positions_.end()) {
+    return true;  // unknown position (not in the map): publish as before
+  }
+
+  const double dx = position->second.x - current_pose.pose.position.x;
+  const double dy = position->second.y - current_pose.pose.position.y;
+  return dx * dx + dy * dy <= traffic_light_relevance_radius_ * traffic_light_relevance_radius_;
 }
 
 // util
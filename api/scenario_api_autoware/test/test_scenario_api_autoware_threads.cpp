@@ -0,0 +1,228 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Concurrent callers of ScenarioAPIAutoware, built with ThreadSanitizer (see
+ * CMakeLists.txt): topic callbacks and timers on a spinning thread publish the
+ * snapshots (std::atomic_store) and the state (state_mutex_) while other
+ * threads read them and issue traffic light commands (traffic_light_mutex_).
+ * Any data race reported by ThreadSanitizer fails the test.
+ */
+
+#include <scenario_api_autoware/scenario_api_autoware.h>
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+#include <lanelet2_core/primitives/LineString.h>
+#include <lanelet2_core/primitives/Point.h>
+#include <lanelet2_core/primitives/RegulatoryElement.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <lanelet2_core/elements/TrafficLight.h>
+#include <lanelet2_extension/utility/message_conversion.h>
+#include <tf2_ros/static_transform_broadcaster.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+extern "C" const char * __tsan_default_options() { return "halt_on_error=1"; }
+
+namespace
+{
+constexpr double duration = 3.0;  // [s] of concurrent calls
+
+lanelet::Id traffic_light_id;
+
+autoware_lanelet2_msgs::MapBin makeMap()
+{
+  using lanelet::utils::getId;
+
+  lanelet::LineString3d left(
+    getId(), {lanelet::Point3d(getId(), 0, 2, 0), lanelet::Point3d(getId(), 50, 2, 0)});
+  lanelet::LineString3d right(
+    getId(), {lanelet::Point3d(getId(), 0, -2, 0), lanelet::Point3d(getId(), 50, -2, 0)});
+  lanelet::Lanelet lane(getId(), left, right);
+  lane.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+
+  lanelet::LineString3d light(
+    getId(), {lanelet::Point3d(getId(), 40, 3, 5), lanelet::Point3d(getId(), 40, 4, 5)});
+  light.attributes()[lanelet::AttributeName::Type] = lanelet::AttributeValueString::TrafficLight;
+  lanelet::LineString3d stop_line(
+    getId(), {lanelet::Point3d(getId(), 38, -2, 0), lanelet::Point3d(getId(), 38, 2, 0)});
+
+  const auto traffic_light = lanelet::TrafficLight::make(getId(), {}, {light}, stop_line);
+  lane.addRegulatoryElement(traffic_light);
+  traffic_light_id = traffic_light->id();
+
+  const lanelet::LaneletMapPtr map = lanelet::utils::createMap({lane});
+  autoware_lanelet2_msgs::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(map, &msg);
+  return msg;
+}
+
+// runs `f` repeatedly on its own thread until `done`
+std::thread repeat(const std::atomic<bool> & done, const std::function<void()> & f)
+{
+  return std::thread([&done, f]() {
+    while (!done) {
+      f();
+    }
+  });
+}
+}  // namespace
+
+TEST(ScenarioAPIAutoware, ConcurrentCallersDoNotRace)
+{
+  ScenarioAPIAutoware api;
+
+  // NOTE: One thread spins, as the runner does; the fast timer spins recursively from it.
+  std::atomic<bool> stopped{false};
+  auto spinning = repeat(stopped, []() {
+    ros::spinOnce();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+
+  ros::NodeHandle pnh("~");
+  auto pub_pcl = pnh.advertise<sensor_msgs::PointCloud2>("input/pointcloud", 1);
+  auto pub_map = pnh.advertise<autoware_lanelet2_msgs::MapBin>("input/vectormap", 1, true);
+  auto pub_route = pnh.advertise<autoware_planning_msgs::Route>("input/route", 1);
+  auto pub_state = pnh.advertise<autoware_system_msgs::AutowareState>("input/autoware_state", 1);
+  auto pub_twist = pnh.advertise<geometry_msgs::TwistStamped>("input/vehicle_twist", 1);
+  auto pub_turn_signal =
+    pnh.advertise<autoware_vehicle_msgs::TurnSignal>("input/signal_command", 1);
+
+  // map -> base_link for the pose timer
+  tf2_ros::StaticTransformBroadcaster broadcaster;
+  geometry_msgs::TransformStamped transform;
+  transform.header.stamp = ros::Time::now();
+  transform.header.frame_id = "map";
+  transform.child_frame_id = "base_link";
+  transform.transform.translation.x = 10.0;
+  transform.transform.rotation.w = 1.0;
+  broadcaster.sendTransform(transform);
+
+  const auto map = makeMap();
+  pub_map.publish(map);
+
+  const auto publishAll = [&](const std::uint32_t sequence) {
+    sensor_msgs::PointCloud2 pcl;
+    pcl.header.frame_id = "base_link";
+    pub_pcl.publish(pcl);
+
+    autoware_planning_msgs::Route route;
+    route.route_sections.resize(1);
+    route.route_sections.front().lane_ids.push_back(sequence);
+    pub_route.publish(route);
+
+    autoware_system_msgs::AutowareState state;
+    state.state = sequence % 2 ? autoware_system_msgs::AutowareState::WaitingForRoute
+                               : autoware_system_msgs::AutowareState::Driving;
+    pub_state.publish(state);
+
+    geometry_msgs::TwistStamped twist;
+    twist.header.stamp = ros::Time::now();
+    twist.twist.linear.x = sequence % 10;
+    pub_twist.publish(twist);
+
+    autoware_vehicle_msgs::TurnSignal turn_signal;
+    turn_signal.data = sequence % 3;
+    pub_turn_signal.publish(turn_signal);
+  };
+
+  // every snapshot set, so that the readers below never see a missing one
+  const auto deadline = ros::WallTime::now() + ros::WallDuration(30.0);
+  for (std::uint32_t sequence = 0; !api.isAPIReady() and ros::WallTime::now() < deadline;
+       ++sequence) {
+    publishAll(sequence);
+    ros::WallDuration(0.05).sleep();
+  }
+  if (!api.isAPIReady()) {
+    stopped = true;
+    spinning.join();
+    FAIL() << "ScenarioAPIAutoware never got ready";
+  }
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> threads;
+
+  std::uint32_t sequence = 0;
+  threads.push_back(repeat(done, [&]() {
+    publishAll(++sequence);
+    if (sequence % 50 == 0) {
+      pub_map.publish(map);  // replaces the lanelet snapshots while they are read
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }));
+
+  threads.push_back(repeat(done, [&]() {
+    api.getVelocity();
+    api.getAccel();
+    api.getJerk();
+    api.getLeftBlinker();
+    api.getRightBlinker();
+    api.getMoveDistance();
+    api.getCurrentPoseRos();
+    api.isAPIReady();
+  }));
+
+  threads.push_back(repeat(done, [&]() {
+    api.isAutowareReadyInitialize();
+    api.isAutowareReadyRouting();
+    api.getPointCloud();
+    api.getRoutingGraph();
+    double speed_limit;
+    for (const auto & lane : api.getLaneletMap()->laneletLayer) {
+      api.getSpeedLimit(lane.id(), speed_limit);
+    }
+  }));
+
+  for (const auto color : {"Red", "Green"}) {
+    threads.push_back(repeat(done, [&api, color]() {
+      api.setTrafficLightsColor(traffic_light_id, color);
+      api.setTrafficLightsArrow(traffic_light_id, "Left");
+      std::string traffic_color;
+      api.getTrafficLightColor(traffic_light_id, &traffic_color);
+      std::vector<std::string> traffic_arrow;
+      api.getTrafficLightArrow(traffic_light_id, &traffic_arrow);
+      api.resetTrafficLightsArrow(traffic_light_id);
+      api.resetTrafficLightsColor(traffic_light_id);
+    }));
+  }
+
+  ros::WallDuration(duration).sleep();
+  done = true;
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_TRUE(api.setTrafficLightsColor(traffic_light_id, "Yellow"));
+  std::string traffic_color;
+  EXPECT_TRUE(api.getTrafficLightColor(traffic_light_id, &traffic_color));
+  EXPECT_EQ(traffic_color, "Yellow");
+
+  stopped = true;
+  spinning.join();
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "test_scenario_api_autoware_threads");
+  return RUN_ALL_TESTS();
+}
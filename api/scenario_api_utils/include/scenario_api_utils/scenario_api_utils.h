@@ -22,6 +22,7 @@
 #include <geometry_msgs/Transform.h>
 #include <geometry_msgs/Twist.h>
 #include <ros/ros.h>
+#include <scenario_api_utils/se2.h>
 #include <tf2/utils.h>
 #include <tf2_ros/static_transform_broadcaster.h>
 #include <tf2_ros/transform_listener.h>
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SCENARIO_API_UTILS_SE2_H_INCLUDED
+#define SCENARIO_API_UTILS_SE2_H_INCLUDED
+
+#include <geometry_msgs/Pose.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+/*
+ * Rigid transform on the plane (rotation + translation).
+ *
+ * The rotation is kept as (cos, sin) of yaw, so composition, inversion and
+ * point transforms need no trigonometric function at all; the yaw angle is
+ * computed (atan2) only when asked. Convert from/to geometry_msgs::Pose at API
+ * boundaries only.
+ */
+struct SE2
+{
+  double x;
+  double y;
+  double c;  //!< @brief cos(yaw)
+  double s;  //!< @brief sin(yaw)
+
+  constexpr SE2() : x(0.0), y(0.0), c(1.0), s(0.0) {}
+
+  constexpr SE2(const double x, const double y, const double c, const double s)
+  : x(x), y(y), c(c), s(s)
+  {
+  }
+
+  static SE2 fromYaw(const double x, const double y, const double yaw)
+  {
+    return SE2(x, y, std::cos(yaw), std::sin(yaw));
+  }
+
+  /* closed-form yaw of quaternion (roll/pitch are ignored) */
+  static SE2 fromQuaternion(
+    const double x, const double y, const double q_x, const double q_y, const double q_z,
+    const double q_w)
+  {
+    const double c = 1.0 - 2.0 * (q_y * q_y + q_z * q_z);
+    const double s = 2.0 * (q_w * q_z + q_x * q_y);
+    const double norm = std::hypot(c, s);
+    return norm > 0.0 ? SE2(x, y, c / norm, s / norm) : SE2(x, y, 1.0, 0.0);
+  }
+
+  static SE2 fromPose(const geometry_msgs::Pose & pose)
+  {
+    return fromQuaternion(
+      pose.position.x, pose.position.y, pose.orientation.x, pose.orientation.y, pose.orientation.z,
+      pose.orientation.w);
+  }
+
+  double yaw() const { return std::atan2(s, c); }
+
+  /* this * rhs */
+  constexpr SE2 operator*(const SE2 & rhs) const
+  {
+    return SE2(
+      x + c * rhs.x - s * rhs.y, y + s * rhs.x + c * rhs.y, c * rhs.c - s * rhs.s,
+      s * rhs.c + c * rhs.s);
+  }
+
+  constexpr SE2 inverse() const { return SE2(-c * x - s * y, s * x - c * y, c, -s); }
+
+  /* yaw of rhs seen from this, in (-pi, pi] */
+  double deltaYaw(const SE2 & rhs) const
+  {
+    return std::atan2(c * rhs.s - s * rhs.c, c * rhs.c + s * rhs.s);
+  }
+
+  constexpr double transformX(const double px, const double py) const { return x + c * px - s * py; }
+  constexpr double transformY(const double px, const double py) const { return y + s * px + c * py; }
+
+  /* transform n points; in and out may be the same arrays */
+  void transform(
+    const double * px, const double * py, double * out_x, double * out_y, const std::size_t n) const
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      const double tx = transformX(px[i], py[i]);
+      const double ty = transformY(px[i], py[i]);
+      out_x[i] = tx;
+      out_y[i] = ty;
+    }
+  }
+
+  geometry_msgs::Pose toPose(const double z = 0.0) const
+  {
+    // half-angle formulae, no trigonometric function
+    geometry_msgs::Pose pose;
+    pose.position.x = x;
+    pose.position.y = y;
+    pose.position.z = z;
+    pose.orientation.z = std::copysign(std::sqrt(std::max(0.0, (1.0 - c) / 2.0)), s);
+    pose.orientation.w = std::sqrt(std::max(0.0, (1.0 + c) / 2.0));
+    return pose;
+  }
+};
+
+#endif  // SCENARIO_API_UTILS_SE2_H_INCLUDED
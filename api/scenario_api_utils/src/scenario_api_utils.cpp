@@ -18,23 +18,11 @@ geometry_msgs::Quaternion quatFromYaw(double yaw)
 
 double yawFromQuat(double q_x, double q_y, double q_z, double q_w)
 {
-  tf2::Quaternion quat(q_x, q_y, q_z, q_w);
-  tf2::Matrix3x3 mat(quat);
-  double roll, pitch, yaw;
-  mat.getRPY(roll, pitch, yaw);
-  // cut roll/pitch information
-  return yaw;
+  // closed form of yaw (roll/pitch information is cut)
+  return std::atan2(2.0 * (q_w * q_z + q_x * q_y), 1.0 - 2.0 * (q_y * q_y + q_z * q_z));
 }
 
-double yawFromQuat(geometry_msgs::Quaternion q)
-{
-  tf2::Quaternion quat(q.x, q.y, q.z, q.w);
-  tf2::Matrix3x3 mat(quat);
-  double roll, pitch, yaw;
-  mat.getRPY(roll, pitch, yaw);
-  // cut roll/pitch information
-  return yaw;
-}
+double yawFromQuat(geometry_msgs::Quaternion q) { return yawFromQuat(q.x, q.y, q.z, q.w); }
 
 geometry_msgs::Pose poseFromValue(
   const double p_x, const double p_y, const double p_z, const double o_x, const double o_y,
@@ -65,10 +53,8 @@ geometry_msgs::Pose poseFromValue(
 geometry_msgs::Pose movePose(const geometry_msgs::Pose & pose, const double move_dist_to_forward)
 {
   geometry_msgs::Pose move_pose = pose;
-  const double yaw = tf2::getYaw(pose.orientation);
-  const double dx = move_dist_to_forward * std::cos(yaw);
-  const double dy = move_dist_to_forward * std::sin(yaw);
-  move_pose.position.x += dx;
-  move_pose.position.y += dy;
+  const SE2 se2 = SE2::fromPose(pose);
+  move_pose.position.x = se2.transformX(move_dist_to_forward, 0.0);
+  move_pose.position.y = se2.transformY(move_dist_to_forward, 0.0);
   return move_pose;
 }
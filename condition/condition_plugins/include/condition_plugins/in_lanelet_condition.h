@@ -0,0 +1,26 @@
+#ifndef CONDITION_PLUGINS_IN_LANELET_CONDITION_H_INCLUDED
+#define CONDITION_PLUGINS_IN_LANELET_CONDITION_H_INCLUDED
+
+#include <scenario_conditions/condition_base.h>
+#include <scenario_intersection/intersection_manager.h>
+#include <scenario_utility/scenario_utility.h>
+
+namespace condition_plugins
+{
+class InLaneletCondition : public scenario_conditions::ConditionBase
+{
+public:
+  InLaneletCondition();
+  bool update(const std::shared_ptr<scenario_intersection::IntersectionManager> &) override;
+  bool configure(YAML::Node node, std::shared_ptr<ScenarioAPI> api_ptr) override;
+
+  bool includes(int lane_id) const;  // NOTE: One of the lanelets given by LaneId.
+
+private:
+  std::string trigger_;
+
+  std::vector<int> lane_ids_;
+};
+}  // namespace condition_plugins
+
+#endif  // CONDITION_PLUGINS_IN_LANELET_CONDITION_H_INCLUDED
@@ -12,11 +12,11 @@ namespace condition_plugins
 class RelativeDistanceCondition
   : public scenario_conditions::ConditionBase
 {
-  std::string trigger_, target_entity_, rule_;
+  std::string trigger_, target_entity_;
 
   float value_;
 
-  Comparator<float> compare_;
+  Rule rule_;
 
 public:
   RelativeDistanceCondition();
@@ -14,9 +14,7 @@ class SimulationTimeCondition
 {
   ros::Duration duration_;
 
-  std::string rule_;
-
-  Comparator<ros::Duration> compare_;
+  Rule rule_;
 
 public:
   SimulationTimeCondition();
@@ -26,6 +24,11 @@ public:
   ros::Duration elapsed() const noexcept;
 
   bool update(const std::shared_ptr<scenario_intersection::IntersectionManager> &) override;
+
+  bool isBatched() const noexcept override { return true; }
+
+  void updateBatch(
+    const std::vector<ConditionBase *> &, const scenario_conditions::Snapshot &, bool *) override;
 };
 
 } // namespace condition_plugins
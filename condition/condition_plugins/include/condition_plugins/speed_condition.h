@@ -17,11 +17,15 @@ public:
   bool update(const std::shared_ptr<scenario_intersection::IntersectionManager> &) override;
   bool configure(YAML::Node node, std::shared_ptr<ScenarioAPI> api_ptr) override;
 
+  bool isBatched() const noexcept override { return true; }
+  void updateBatch(
+    const std::vector<ConditionBase *> &, const scenario_conditions::Snapshot &, bool *) override;
+
 private:
-  std::string rule_;
+  Rule rule_;
   std::string trigger_;
   float value_;
-  Comparator<float> compare_;
+  std::size_t hint_ = 0;
 };
 
 }  // namespace condition_plugins
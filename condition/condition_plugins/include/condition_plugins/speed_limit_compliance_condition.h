@@ -0,0 +1,63 @@
+#ifndef CONDITION_PLUGINS_SPEED_LIMIT_COMPLIANCE_CONDITION_H_INCLUDED
+#define CONDITION_PLUGINS_SPEED_LIMIT_COMPLIANCE_CONDITION_H_INCLUDED
+
+#include <scenario_conditions/condition_base.h>
+#include <scenario_intersection/intersection_manager.h>
+#include <scenario_logger/logger.h>
+#include <scenario_utility/scenario_utility.h>
+
+namespace condition_plugins
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * SPEED LIMIT COMPLIANCE
+ *
+ * Holds while the trigger exceeds the speed limit of its lanelet by more than
+ * Tolerance [m/s] (default 0), i.e. on a violation, so that it can be given
+ * as a failure condition. The lanelet is the one assigned by
+ * ScenarioAPI::updateEntityStates and its limit was precomputed at map load;
+ * off the map, the condition does not hold.
+ *
+ * Every instance reports its violation time [s], the number of violations and
+ * the maximum excess [m/s] to the log metadata (speed_limit_compliance.<Name>),
+ * whether it is evaluated in an end condition or not. The metadata is provided
+ * when the log is written, from counts that outlive the instance.
+ *
+ * -------------------------------------------------------------------------- */
+class SpeedLimitComplianceCondition : public scenario_conditions::ConditionBase
+{
+public:
+  SpeedLimitComplianceCondition();
+  bool update(const std::shared_ptr<scenario_intersection::IntersectionManager> &) override;
+  bool configure(YAML::Node node, std::shared_ptr<ScenarioAPI> api_ptr) override;
+
+  bool isBatched() const noexcept override { return true; }
+  void updateBatch(
+    const std::vector<ConditionBase *> &, const scenario_conditions::Snapshot &, bool *) override;
+
+  struct Kpi
+  {
+    double violation_time = 0;  // [s]
+    std::size_t violations = 0;
+    double max_excess = 0;  // [m/s]
+
+    bool violating = false;
+    ros::Time checked;
+
+    void account(const ros::Time & now, bool violation, double excess);
+  };
+
+private:
+  std::string trigger_;
+  double tolerance_;  // [m/s]
+  std::size_t hint_ = 0;
+
+  std::shared_ptr<Kpi> kpi_;
+
+  bool check(const std::vector<EntityState> &, double & margin);
+};
+
+}  // namespace condition_plugins
+
+#endif  // CONDITION_PLUGINS_SPEED_LIMIT_COMPLIANCE_CONDITION_H_INCLUDED
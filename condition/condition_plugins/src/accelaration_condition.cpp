@@ -1,5 +1,11 @@
 #include <condition_plugins/acceleration_condition.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
 namespace condition_plugins
 {
 
@@ -22,7 +28,7 @@ try
 
   value_ = read_essential<float>(node_, "Value");
 
-  if (not parseRule<float>(read_essential<std::string>(node_, "Rule"), compare_))
+  if (not parseRule(read_essential<std::string>(node_, "Rule"), rule_))
   {
     return configured_ = false;
   }
@@ -37,34 +43,102 @@ catch (...)
   SCENARIO_RETHROW_ERROR_FROM_CONDITION_CONFIGURATION();
 }
 
-bool AccelerationCondition::update(
-  const std::shared_ptr<scenario_intersection::IntersectionManager> &)
+bool AccelerationCondition::getAcceleration(float& acceleration) const
 {
-  if (keep_ && result_)
+  if ((*api_ptr_).isEgoCarName(trigger_))
   {
-    return result_;
+    acceleration = (*api_ptr_).getAccel();
+    return true;
   }
   else
   {
-    if ((*api_ptr_).isEgoCarName(trigger_))
+    double npc_acceleration { 0.0 };
+
+    if (not (*api_ptr_).getNPCAccel(trigger_, &npc_acceleration))
     {
-      return result_ = compare_((*api_ptr_).getAccel(), value_);
+      SCENARIO_ERROR_STREAM(CATEGORY(), "Invalid trigger name specified for " << getType() << " condition named " << getName());
+      return false;
     }
     else
     {
-      double npc_acceleration { 0.0 };
+      acceleration = npc_acceleration;
+      return true;
+    }
+  }
+}
 
-      if (not (*api_ptr_).getNPCAccel(trigger_, &npc_acceleration))
-      {
-        ROS_ERROR_STREAM("Invalid trigger name specified for " << getType() << " condition named " << getName());
-        return result_ = false;
-      }
-      else
+bool AccelerationCondition::update(
+  const std::shared_ptr<scenario_intersection::IntersectionManager> &)
+{
+  if (keep_ and result_)
+  {
+    return result_;  // NOTE: The robustness keeps the maximum it had when latched.
+  }
+
+  float acceleration { 0.0 };
+
+  if (not getAcceleration(acceleration))
+  {
+    updateRobustness(-std::numeric_limits<double>::infinity());
+    return result_ = false;  // NOTE: Whatever the rule.
+  }
+
+  updateRobustness(margin(rule_, acceleration, value_));
+
+  return result_ = compare(rule_, acceleration, value_);
+}
+
+void AccelerationCondition::updateBatch(
+  const std::vector<ConditionBase *> & instances,
+  const scenario_conditions::Snapshot &,
+  bool * results)
+{
+  // NOTE: Acceleration is not part of the snapshot; each trigger is looked up once per tick.
+  std::vector<std::pair<const std::string*, std::size_t>> looked_up {};  // index of the first instance
+
+  std::vector<float> accelerations(instances.size());
+
+  // NOTE: Not a NaN acceleration, which satisfies not_equal; these are false whatever the rule.
+  std::vector<std::uint8_t> found(instances.size());
+
+  for (std::size_t i {0}; i < instances.size(); ++i)
+  {
+    const auto& each { static_cast<const AccelerationCondition&>(*instances[i]) };
+
+    if (each.keep_ and each.result_)
+    {
+      continue;  // NOTE: Latched, so neither looked up nor reported.
+    }
+
+    const auto iter {
+      std::find_if(looked_up.begin(), looked_up.end(), [&](const auto& x)
       {
-        return result_ = compare_(npc_acceleration, value_);
-      }
+        return *x.first == each.trigger_;
+      })
+    };
+
+    if (iter != looked_up.end())
+    {
+      accelerations[i] = accelerations[iter->second];
+      found[i] = found[iter->second];
+    }
+    else
+    {
+      found[i] = each.getAcceleration(accelerations[i]);
+
+      looked_up.emplace_back(&each.trigger_, i);
     }
   }
+
+  for (std::size_t i {0}; i < instances.size(); ++i)
+  {
+    auto& each { static_cast<AccelerationCondition&>(*instances[i]) };
+
+    results[i] = found[i] and compare(each.rule_, accelerations[i], each.value_);
+
+    each.batched_margin_ =
+      found[i] ? margin(each.rule_, accelerations[i], each.value_) : -std::numeric_limits<double>::infinity();
+  }
 }
 
 }  // namespace condition_plugins
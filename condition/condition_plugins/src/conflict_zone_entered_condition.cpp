@@ -0,0 +1,55 @@
+#include <condition_plugins/conflict_zone_entered_condition.h>
+#include <scenario_logger/logger.h>
+
+namespace condition_plugins
+{
+
+ConflictZoneEnteredCondition::ConflictZoneEnteredCondition()
+  : scenario_conditions::ConditionBase {"ConflictZoneEntered"}
+{}
+
+bool ConflictZoneEnteredCondition::configure(YAML::Node node, std::shared_ptr<ScenarioAPI> api_ptr)
+try
+{
+  node_ = node;
+  api_ptr_ = api_ptr;
+
+  name_ = read_optional<std::string>(node_, "Name", name_);
+
+  trigger_ = read_essential<std::string>(node_, "Trigger");
+
+  // NOTE: Without LaneId, any conflict zone counts.
+  lane_id_ = read_optional<int>(node_, "LaneId", -1);
+
+  keep_ = read_optional<bool>(node_, "Keep", false);
+
+  return configured_ = true;
+}
+catch (...)
+{
+  configured_ = false;
+  SCENARIO_RETHROW_ERROR_FROM_CONDITION_CONFIGURATION();
+}
+
+bool ConflictZoneEnteredCondition::update(
+  const std::shared_ptr<scenario_intersection::IntersectionManager> &)
+{
+  if (!configured_)
+  {
+    SCENARIO_THROW_ERROR_ABOUT_INCOMPLETE_CONFIGURATION();
+  }
+
+  if (keep_ && result_)
+  {
+    return result_;
+  }
+  else
+  {
+    return result_ = (*api_ptr_).isInConflictZone(trigger_, lane_id_);
+  }
+}
+
+}  // namespace condition_plugins
+
+#include <pluginlib/class_list_macros.h>
+PLUGINLIB_EXPORT_CLASS(condition_plugins::ConflictZoneEnteredCondition, scenario_conditions::ConditionBase)
@@ -0,0 +1,55 @@
+#include <condition_plugins/conflict_zone_occupied_condition.h>
+#include <scenario_logger/logger.h>
+
+namespace condition_plugins
+{
+
+ConflictZoneOccupiedCondition::ConflictZoneOccupiedCondition()
+  : scenario_conditions::ConditionBase {"ConflictZoneOccupied"}
+{}
+
+bool ConflictZoneOccupiedCondition::configure(YAML::Node node, std::shared_ptr<ScenarioAPI> api_ptr)
+try
+{
+  node_ = node;
+  api_ptr_ = api_ptr;
+
+  name_ = read_optional<std::string>(node_, "Name", name_);
+
+  trigger_ = read_essential<std::string>(node_, "Trigger");
+
+  // NOTE: Without TargetEntity, any other entity counts.
+  target_entity_ = read_optional<std::string>(node_, "TargetEntity", "");
+
+  keep_ = read_optional<bool>(node_, "Keep", false);
+
+  return configured_ = true;
+}
+catch (...)
+{
+  configured_ = false;
+  SCENARIO_RETHROW_ERROR_FROM_CONDITION_CONFIGURATION();
+}
+
+bool ConflictZoneOccupiedCondition::update(
+  const std::shared_ptr<scenario_intersection::IntersectionManager> &)
+{
+  if (!configured_)
+  {
+    SCENARIO_THROW_ERROR_ABOUT_INCOMPLETE_CONFIGURATION();
+  }
+
+  if (keep_ && result_)
+  {
+    return result_;
+  }
+  else
+  {
+    return result_ = (*api_ptr_).isConflictZoneOccupiedByOther(trigger_, target_entity_);
+  }
+}
+
+}  // namespace condition_plugins
+
+#include <pluginlib/class_list_macros.h>
+PLUGINLIB_EXPORT_CLASS(condition_plugins::ConflictZoneOccupiedCondition, scenario_conditions::ConditionBase)
@@ -0,0 +1,79 @@
+#include <condition_plugins/in_lanelet_condition.h>
+#include <scenario_logger/logger.h>
+
+#include <algorithm>
+
+namespace condition_plugins
+{
+
+InLaneletCondition::InLaneletCondition()
+  : scenario_conditions::ConditionBase {"InLanelet"}
+{}
+
+bool InLaneletCondition::configure(YAML::Node node, std::shared_ptr<ScenarioAPI> api_ptr)
+try
+{
+  node_ = node;
+  api_ptr_ = api_ptr;
+
+  name_ = read_optional<std::string>(node_, "Name", name_);
+
+  trigger_ = read_essential<std::string>(node_, "Trigger");
+
+  call_with_essential(node_, "LaneId", [&](const auto& node)
+  {
+    if (node.IsSequence())
+    {
+      lane_ids_ = node.template as<std::vector<int>>();
+    }
+    else
+    {
+      lane_ids_ = { node.template as<int>() };
+    }
+  });
+
+  keep_ = read_optional<bool>(node_, "Keep", false);
+
+  return configured_ = true;
+}
+catch (...)
+{
+  configured_ = false;
+  SCENARIO_RETHROW_ERROR_FROM_CONDITION_CONFIGURATION();
+}
+
+bool InLaneletCondition::update(
+  const std::shared_ptr<scenario_intersection::IntersectionManager> &)
+{
+  if (!configured_)
+  {
+    SCENARIO_THROW_ERROR_ABOUT_INCOMPLETE_CONFIGURATION();
+  }
+
+  if (keep_ && result_)
+  {
+    return result_;
+  }
+  else
+  {
+    int lane_id {0};
+
+    // NOTE: Lane assignment is computed once per tick by ScenarioAPI::updateEntityStates.
+    if (not (*api_ptr_).getEntityLaneID(trigger_, lane_id))
+    {
+      return result_ = false;
+    }
+
+    return result_ = includes(lane_id);
+  }
+}
+
+bool InLaneletCondition::includes(int lane_id) const
+{
+  return std::find(lane_ids_.begin(), lane_ids_.end(), lane_id) != lane_ids_.end();
+}
+
+}  // namespace condition_plugins
+
+#include <pluginlib/class_list_macros.h>
+PLUGINLIB_EXPORT_CLASS(condition_plugins::InLaneletCondition, scenario_conditions::ConditionBase)
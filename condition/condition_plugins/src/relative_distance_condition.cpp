@@ -29,7 +29,7 @@ try
 
   value_ = read_essential<float>(node_, "Value");
 
-  if (not parseRule<float>(read_essential<std::string>(node_, "Rule"), compare_))
+  if (not parseRule(read_essential<std::string>(node_, "Rule"), rule_))
   {
     return configured_ = false;
   }
@@ -49,23 +49,23 @@ bool RelativeDistanceCondition::update(
 {
   if (keep_ and result_)
   {
-    return result_;
+    return result_;  // NOTE: The robustness keeps the maximum it had when latched.
+  }
+
+  double distance {0};
+
+  if ((*api_ptr_).isEgoCarName(trigger_))
+  {
+    (*api_ptr_).calcDistToNPC(distance, target_entity_);
   }
   else
   {
-    double distance {0};
-
-    if ((*api_ptr_).isEgoCarName(trigger_))
-    {
-      (*api_ptr_).calcDistToNPC(distance, target_entity_);
-    }
-    else
-    {
-      (*api_ptr_).calcDistToNPCFromNPC(distance, trigger_, target_entity_);
-    }
-
-    return result_ = compare_(distance, value_);
+    (*api_ptr_).calcDistToNPCFromNPC(distance, trigger_, target_entity_);
   }
+
+  updateRobustness(margin(rule_, distance, value_));
+
+  return result_ = compare<float>(rule_, distance, value_);
 }
 
 } // namespace condition_plugins
@@ -0,0 +1,54 @@
+#include <condition_plugins/same_lane_condition.h>
+#include <scenario_logger/logger.h>
+
+namespace condition_plugins
+{
+
+SameLaneCondition::SameLaneCondition()
+  : scenario_conditions::ConditionBase {"SameLane"}
+{}
+
+bool SameLaneCondition::configure(YAML::Node node, std::shared_ptr<ScenarioAPI> api_ptr)
+try
+{
+  node_ = node;
+  api_ptr_ = api_ptr;
+
+  name_ = read_optional<std::string>(node_, "Name", name_);
+
+  trigger_ = read_essential<std::string>(node_, "Trigger");
+
+  target_entity_ = read_essential<std::string>(node_, "TargetEntity");
+
+  keep_ = read_optional<bool>(node_, "Keep", false);
+
+  return configured_ = true;
+}
+catch (...)
+{
+  configured_ = false;
+  SCENARIO_RETHROW_ERROR_FROM_CONDITION_CONFIGURATION();
+}
+
+bool SameLaneCondition::update(
+  const std::shared_ptr<scenario_intersection::IntersectionManager> &)
+{
+  if (!configured_)
+  {
+    SCENARIO_THROW_ERROR_ABOUT_INCOMPLETE_CONFIGURATION();
+  }
+
+  if (keep_ && result_)
+  {
+    return result_;
+  }
+  else
+  {
+    return result_ = (*api_ptr_).isInSameLane(trigger_, target_entity_);
+  }
+}
+
+}  // namespace condition_plugins
+
+#include <pluginlib/class_list_macros.h>
+PLUGINLIB_EXPORT_CLASS(condition_plugins::SameLaneCondition, scenario_conditions::ConditionBase)
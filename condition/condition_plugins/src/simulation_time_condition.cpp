@@ -20,9 +20,7 @@ try
     ros::Duration(
       read_essential<float>(node_, "Value"));
 
-  if (not parseRule<ros::Duration>(
-            read_essential<std::string>(node_, "Rule"),
-            compare_))
+  if (not parseRule(read_essential<std::string>(node_, "Rule"), rule_))
   {
     return configured_ = false;
   }
@@ -39,19 +37,33 @@ catch (...)
 
 ros::Duration SimulationTimeCondition::elapsed() const noexcept
 {
-  return ros::Time::now() - scenario_logger::log.begin();
+  return scenario_logger::now() - scenario_logger::log.begin();
 }
 
 bool SimulationTimeCondition::update(
   const std::shared_ptr<scenario_intersection::IntersectionManager> &)
 {
-  if (keep_ && result_)
-  {
-    return true;
-  }
-  else
+  const auto now { elapsed() };
+
+  updateRobustness(margin(rule_, now, duration_));
+
+  return result_ = (keep_ and result_) or compare(rule_, now, duration_);
+}
+
+void SimulationTimeCondition::updateBatch(
+  const std::vector<ConditionBase *> & instances,
+  const scenario_conditions::Snapshot &,
+  bool * results)
+{
+  const auto now { elapsed() };
+
+  for (std::size_t i {0}; i < instances.size(); ++i)
   {
-    return result_ = compare_(elapsed(), duration_);
+    auto& each { static_cast<SimulationTimeCondition&>(*instances[i]) };
+
+    results[i] = compare(each.rule_, now, each.duration_);
+
+    each.batched_margin_ = margin(each.rule_, now, each.duration_);
   }
 }
 
@@ -1,5 +1,9 @@
 #include <condition_plugins/speed_condition.h>
 
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 namespace condition_plugins
 {
 
@@ -21,7 +25,7 @@ try
 
   value_ = read_essential<float>(node_, "Value");
 
-  if (not parseRule<float>(read_essential<std::string>(node_, "Rule"), compare_))
+  if (not parseRule(read_essential<std::string>(node_, "Rule"), rule_))
   {
     return configured_ = false;
   }
@@ -39,31 +43,76 @@ catch (...)
 bool SpeedCondition::update(
   const std::shared_ptr<scenario_intersection::IntersectionManager> &)
 {
-  if (keep_ && result_)
+  if (keep_ and result_)
   {
-    return true;
+    return result_;  // NOTE: The robustness keeps the maximum it had when latched.
+  }
+
+  float velocity { 0.0 };
+
+  if ((*api_ptr_).isEgoCarName(trigger_))
+  {
+    velocity = (*api_ptr_).getVelocity();
   }
   else
   {
-    if ((*api_ptr_).isEgoCarName(trigger_))
+    double npc_velocity { 0.0 };
+
+    if (not (*api_ptr_).getNPCVelocity(trigger_, &npc_velocity))
+    {
+      SCENARIO_ERROR_STREAM(CATEGORY(), "Invalid trigger name specified for " << getType() << " condition named " << getName());
+      updateRobustness(-std::numeric_limits<double>::infinity());
+      return result_ = false;  // NOTE: Whatever the rule.
+    }
+    else
+    {
+      velocity = npc_velocity;
+    }
+  }
+
+  updateRobustness(margin(rule_, velocity, value_));
+
+  return result_ = compare(rule_, velocity, value_);
+}
+
+void SpeedCondition::updateBatch(
+  const std::vector<ConditionBase *> & instances,
+  const scenario_conditions::Snapshot & snapshot,
+  bool * results)
+{
+  std::vector<float> velocities(instances.size());
+
+  // NOTE: Not a NaN velocity, which satisfies not_equal; these are false whatever the rule.
+  std::vector<std::uint8_t> found(instances.size());
+
+  for (std::size_t i {0}; i < instances.size(); ++i)
+  {
+    auto& each { static_cast<SpeedCondition&>(*instances[i]) };
+
+    if (each.keep_ and each.result_)
     {
-      return result_ = compare_((*api_ptr_).getVelocity(), value_);
+      continue;  // NOTE: Latched, so neither looked up nor reported.
+    }
+    else if (const auto entity { scenario_conditions::findEntity(snapshot.entities, each.trigger_, each.hint_) })
+    {
+      velocities[i] = entity->twist.linear.x;
+      found[i] = true;
     }
     else
     {
-      double npc_velocity { 0.0 };
-
-      if (not (*api_ptr_).getNPCVelocity(trigger_, &npc_velocity))
-      {
-        ROS_ERROR_STREAM("Invalid trigger name specified for " << getType() << " condition named " << getName());
-        return result_ = false;
-      }
-      else
-      {
-        return result_ = compare_(npc_velocity, value_);
-      }
+      SCENARIO_ERROR_STREAM(CATEGORY(), "Invalid trigger name specified for " << each.getType() << " condition named " << each.getName());
     }
   }
+
+  for (std::size_t i {0}; i < instances.size(); ++i)
+  {
+    auto& each { static_cast<SpeedCondition&>(*instances[i]) };
+
+    results[i] = found[i] and compare(each.rule_, velocities[i], each.value_);
+
+    each.batched_margin_ =
+      found[i] ? margin(each.rule_, velocities[i], each.value_) : -std::numeric_limits<double>::infinity();
+  }
 }
 
 }  // namespace condition_plugins
@@ -0,0 +1,138 @@
+#include <condition_plugins/speed_limit_compliance_condition.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace condition_plugins
+{
+
+SpeedLimitComplianceCondition::SpeedLimitComplianceCondition()
+  : scenario_conditions::ConditionBase {"SpeedLimitCompliance"}
+{}
+
+bool SpeedLimitComplianceCondition::configure(
+  YAML::Node node,
+  std::shared_ptr<ScenarioAPI> api_ptr)
+try
+{
+  node_ = node;
+  api_ptr_ = api_ptr;
+
+  name_ = read_optional<std::string>(node_, "Name", name_);
+
+  trigger_ = read_essential<std::string>(node_, "Trigger");
+
+  tolerance_ = read_optional<double>(node_, "Tolerance", 0.0);
+
+  keep_ = read_optional<bool>(node_, "Keep", false);
+
+  kpi_ = std::make_shared<Kpi>();
+
+  // NOTE: Dots in the name would be taken as a path.
+  auto key { name_ };
+  std::replace(key.begin(), key.end(), '.', '_');
+
+  scenario_logger::log.setMetadataProvider("speed_limit_compliance." + key,
+    [kpi = kpi_, trigger = trigger_, tolerance = tolerance_]()
+    {
+      boost::property_tree::ptree tree {};
+
+      tree.put("trigger", trigger);
+      tree.put("tolerance", tolerance);
+      tree.put("violation_time", kpi->violation_time);
+      tree.put("violations", kpi->violations);
+      tree.put("max_excess", kpi->max_excess);
+
+      return tree;
+    });
+
+  return configured_ = true;
+}
+catch (...)
+{
+  configured_ = false;
+  SCENARIO_RETHROW_ERROR_FROM_CONDITION_CONFIGURATION();
+}
+
+void SpeedLimitComplianceCondition::Kpi::account(const ros::Time & now, bool violation, double excess)
+{
+  // NOTE: The time since the last check is counted in the state found then.
+  if (violating)
+  {
+    violation_time += (now - checked).toSec();
+  }
+
+  checked = now;
+
+  if (violation)
+  {
+    violations += not violating;
+    max_excess = std::max(max_excess, excess);
+  }
+
+  violating = violation;
+}
+
+bool SpeedLimitComplianceCondition::check(const std::vector<EntityState> & entities, double & margin)
+{
+  double speed { std::numeric_limits<double>::quiet_NaN() };  // NOTE: Compares false with every rule.
+  double speed_limit { std::numeric_limits<double>::quiet_NaN() };
+
+  if (const auto entity { scenario_conditions::findEntity(entities, trigger_, hint_) })
+  {
+    // NOTE: Not found off the map, which is no violation.
+    if ((*api_ptr_).getEntitySpeedLimit(trigger_, speed_limit))
+    {
+      speed = std::abs(entity->twist.linear.x);
+    }
+  }
+  else
+  {
+    SCENARIO_ERROR_STREAM(CATEGORY(), "Invalid trigger name specified for " << getType() << " condition named " << getName());
+  }
+
+  margin = scenario_utility::parse::margin(Rule::greater, speed, speed_limit + tolerance_);
+
+  const auto violating { compare(Rule::greater, speed, speed_limit + tolerance_) };
+
+  kpi_->account(scenario_logger::now(), violating, speed - speed_limit);
+
+  return violating;
+}
+
+bool SpeedLimitComplianceCondition::update(
+  const std::shared_ptr<scenario_intersection::IntersectionManager> &)
+{
+  if (!configured_)
+  {
+    SCENARIO_THROW_ERROR_ABOUT_INCOMPLETE_CONFIGURATION();
+  }
+
+  double margin { 0 };
+
+  const auto violating { check((*api_ptr_).getEntityStates(), margin) };
+
+  updateRobustness(margin);
+
+  return result_ = (keep_ and result_) or violating;
+}
+
+void SpeedLimitComplianceCondition::updateBatch(
+  const std::vector<ConditionBase *> & instances,
+  const scenario_conditions::Snapshot & snapshot,
+  bool * results)
+{
+  for (std::size_t i {0}; i < instances.size(); ++i)
+  {
+    auto& each { static_cast<SpeedLimitComplianceCondition&>(*instances[i]) };
+
+    results[i] = each.check(snapshot.entities, each.batched_margin_);
+  }
+}
+
+}  // namespace condition_plugins
+
+#include <pluginlib/class_list_macros.h>
+PLUGINLIB_EXPORT_CLASS(condition_plugins::SpeedLimitComplianceCondition, scenario_conditions::ConditionBase)
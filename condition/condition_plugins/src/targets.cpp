@@ -2,8 +2,13 @@
 #include <src/always_false_condition.cpp>
 #include <src/always_true_condition.cpp>
 #include <src/collision_by_entity_condition.cpp>
+#include <src/conflict_zone_entered_condition.cpp>
+#include <src/conflict_zone_occupied_condition.cpp>
+#include <src/in_lanelet_condition.cpp>
 #include <src/reach_position_condition.cpp>
 #include <src/relative_distance_condition.cpp>
+#include <src/same_lane_condition.cpp>
 #include <src/signal_condition.cpp>
 #include <src/simulation_time_condition.cpp>
 #include <src/speed_condition.cpp>
+#include <src/speed_limit_compliance_condition.cpp>
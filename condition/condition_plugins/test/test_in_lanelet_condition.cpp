@@ -0,0 +1,64 @@
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <condition_plugins/in_lanelet_condition.h>
+
+using condition_plugins::InLaneletCondition;
+
+namespace
+{
+
+// NOTE: Configuration only stores the API, which is first used by update.
+void configure(InLaneletCondition& condition, const std::string& yaml)
+{
+  condition.configure(YAML::Load(yaml), nullptr);
+}
+
+}  // namespace
+
+TEST(InLanelet, TakesSingleLaneId)
+{
+  InLaneletCondition condition {};
+
+  configure(condition, "{ Type: InLanelet, Trigger: ego, LaneId: 34513 }");
+
+  EXPECT_TRUE(condition.includes(34513));
+  EXPECT_FALSE(condition.includes(34514));
+}
+
+TEST(InLanelet, TakesSequenceOfLaneIds)
+{
+  InLaneletCondition condition {};
+
+  configure(condition, "{ Type: InLanelet, Trigger: ego, LaneId: [ 34513, 34600, 34621 ] }");
+
+  EXPECT_TRUE(condition.includes(34513));
+  EXPECT_TRUE(condition.includes(34600));
+  EXPECT_TRUE(condition.includes(34621));
+  EXPECT_FALSE(condition.includes(34514));
+  EXPECT_FALSE(condition.includes(0));
+}
+
+TEST(InLanelet, RequiresTriggerAndLaneId)
+{
+  InLaneletCondition condition {};
+
+  EXPECT_THROW(configure(condition, "{ Type: InLanelet, Trigger: ego }"), std::runtime_error);
+  EXPECT_THROW(configure(condition, "{ Type: InLanelet, LaneId: 34513 }"), std::runtime_error);
+  EXPECT_THROW(configure(condition, "{ Type: InLanelet, Trigger: ego, LaneId: lane }"), std::exception);
+}
+
+TEST(InLanelet, RefusesUpdateUnlessConfigured)
+{
+  InLaneletCondition condition {};
+
+  EXPECT_THROW(condition.update(nullptr), std::runtime_error);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <condition_plugins/speed_limit_compliance_condition.h>
+
+using Kpi = condition_plugins::SpeedLimitComplianceCondition::Kpi;
+
+namespace
+{
+
+ros::Time at(double seconds)
+{
+  return ros::Time(seconds);
+}
+
+}  // namespace
+
+TEST(SpeedLimitCompliance, CountsEachViolationOnce)
+{
+  Kpi kpi {};
+
+  kpi.account(at(0), false, -1);
+  kpi.account(at(1), true, 2);
+  kpi.account(at(2), true, 3);
+  kpi.account(at(3), false, -1);
+  kpi.account(at(4), true, 1);
+  kpi.account(at(5), false, -1);
+
+  EXPECT_EQ(kpi.violations, 2u);
+}
+
+// NOTE: The time since the last check is counted in the state found then.
+TEST(SpeedLimitCompliance, AccumulatesViolationTime)
+{
+  Kpi kpi {};
+
+  kpi.account(at(0.0), false, -1);
+  kpi.account(at(0.5), true, 1);
+  kpi.account(at(1.5), true, 1);
+  kpi.account(at(2.0), false, -1);
+  kpi.account(at(3.0), false, -1);
+  kpi.account(at(3.25), true, 1);
+
+  EXPECT_DOUBLE_EQ(kpi.violation_time, 1.5);
+
+  kpi.account(at(4.0), true, 1);
+
+  EXPECT_DOUBLE_EQ(kpi.violation_time, 2.25);
+  EXPECT_EQ(kpi.violations, 2u);
+}
+
+TEST(SpeedLimitCompliance, KeepsMaximumExcessOfViolations)
+{
+  Kpi kpi {};
+
+  kpi.account(at(0), true, 0.5);
+  kpi.account(at(1), true, 4.0);
+  kpi.account(at(2), true, 2.0);
+  kpi.account(at(3), false, 9.0);  // NOTE: Not a violation, e.g. within the tolerance.
+
+  EXPECT_DOUBLE_EQ(kpi.max_excess, 4.0);
+}
+
+TEST(SpeedLimitCompliance, CountsNothingWithoutViolation)
+{
+  Kpi kpi {};
+
+  for (int second {0}; second < 10; ++second)
+  {
+    kpi.account(at(second), false, -1);
+  }
+
+  EXPECT_EQ(kpi.violations, 0u);
+  EXPECT_EQ(kpi.violation_time, 0);
+  EXPECT_EQ(kpi.max_excess, 0);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
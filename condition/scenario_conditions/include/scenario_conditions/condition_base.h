@@ -6,10 +6,45 @@
 #include <scenario_api/scenario_api_core.h>
 #include <scenario_intersection/intersection_manager.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 namespace scenario_conditions
 {
+/* -----------------------------------------------------------------------------
+ *
+ * What a batched update receives: the state of the current tick, taken once.
+ *
+ * -------------------------------------------------------------------------- */
+struct Snapshot
+{
+  const std::vector<EntityState> & entities;
+  const std::shared_ptr<scenario_intersection::IntersectionManager> & intersections;
+};
+
+/* find entity by name, trying the index it was found at last time first */
+inline const EntityState * findEntity(
+  const std::vector<EntityState> & entities, const std::string & name, std::size_t & hint)
+{
+  if (hint < entities.size() and entities[hint].name == name) {
+    return &entities[hint];
+  }
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    if (entities[i].name == name) {
+      return &entities[(hint = i)];
+    }
+  }
+  return nullptr;
+}
+
+class ConditionGroups;
+
 class ConditionBase
 {
+  friend ConditionGroups;
+
 public:
   ConditionBase() = default;
 
@@ -30,6 +65,55 @@ public:
 
   const std::string & getType() const noexcept { return type_; }
 
+  bool getKeep() const noexcept { return keep_; }
+
+  /* ---------------------------------------------------------------------------
+   *
+   * ROBUSTNESS
+   *
+   * Signed margin of the result (see margin in scenario_utility): non-negative
+   * while the condition holds, and the larger the further from flipping. With
+   * Keep, the maximum so far ("eventually"). Conditions that do not compute a
+   * margin report +/-infinity according to their result.
+   *
+   * ------------------------------------------------------------------------ */
+  double getRobustness() const noexcept
+  {
+    return std::isnan(robustness_) ? (result_ ? 1 : -1) * std::numeric_limits<double>::infinity()
+                                   : robustness_;
+  }
+
+  /* ---------------------------------------------------------------------------
+   *
+   * BATCHED INTERFACE
+   *
+   * A type whose result depends only on the state of the current tick may
+   * return true from isBatched. All instances of such a type are then updated
+   * together, once per tick, by a single call of updateBatch on one of them,
+   * which fills results (one per instance, in order). Every instance reads its
+   * result with updateFromBatch when evaluated, where Keep is applied.
+   *
+   * The default updateBatch adapts the per-instance update.
+   *
+   * ------------------------------------------------------------------------ */
+  virtual bool isBatched() const noexcept { return false; }
+
+  virtual void updateBatch(
+    const std::vector<ConditionBase *> & instances, const Snapshot & snapshot, bool * results)
+  {
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+      results[i] = instances[i]->update(snapshot.intersections);
+    }
+  }
+
+  bool updateFromBatch() noexcept
+  {
+    if (not std::isnan(batched_margin_)) {
+      updateRobustness(batched_margin_);
+    }
+    return result_ = (keep_ and result_) or batched_result_;
+  }
+
 protected:
   std::shared_ptr<ScenarioAPI> api_ptr_;
   YAML::Node node_;
@@ -37,6 +121,15 @@ protected:
   bool configured_ = false;
   bool keep_ = false;
   bool result_ = false;
+  bool batched_result_ = false;  //!< @brief result of the last batched update
+
+  double robustness_ = std::numeric_limits<double>::quiet_NaN();      //!< @brief NaN unless computed
+  double batched_margin_ = std::numeric_limits<double>::quiet_NaN();  //!< @brief set by updateBatch
+
+  void updateRobustness(double margin) noexcept
+  {
+    robustness_ = (keep_ and not std::isnan(robustness_)) ? std::max(robustness_, margin) : margin;
+  }
 
   std::string name_;
   std::string type_;
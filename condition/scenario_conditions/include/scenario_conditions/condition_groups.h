@@ -0,0 +1,50 @@
+#ifndef SCENARIO_CONDITIONS_CONDITION_GROUPS_H_INCLUDED
+#define SCENARIO_CONDITIONS_CONDITION_GROUPS_H_INCLUDED
+
+#include <boost/shared_ptr.hpp>
+
+#include <scenario_conditions/condition_base.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace scenario_conditions
+{
+/* -----------------------------------------------------------------------------
+ *
+ * Instances of batched condition types, grouped by type. Updated once at the
+ * beginning of each tick, i.e. one virtual call per type instead of one per
+ * instance. Only active instances are updated: those whose owner (e.g. a
+ * sequence waiting to start, or the current event of a sequence) may evaluate
+ * them in that tick. Instances are active when added.
+ *
+ * -------------------------------------------------------------------------- */
+class ConditionGroups
+{
+public:
+  bool add(const boost::shared_ptr<ConditionBase> & condition);  //!< @brief false if not batched
+
+  void remove(const boost::shared_ptr<ConditionBase> & condition);  //!< @brief no longer evaluated
+
+  void activate(const boost::shared_ptr<ConditionBase> & condition, bool active);
+
+  void update(const Snapshot & snapshot);
+
+private:
+  struct Group
+  {
+    std::vector<boost::shared_ptr<ConditionBase>> owners;
+    std::vector<ConditionBase *> instances;
+    std::vector<bool> active;
+    std::vector<ConditionBase *> batch;  //!< @brief the active instances, rebuilt every tick
+    std::unique_ptr<bool[]> results;
+  };
+
+  std::map<std::string, Group> groups_;
+};
+
+}  // namespace scenario_conditions
+
+#endif  // SCENARIO_CONDITIONS_CONDITION_GROUPS_H_INCLUDED
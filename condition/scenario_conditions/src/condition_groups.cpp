@@ -0,0 +1,100 @@
+#include <scenario_conditions/condition_groups.h>
+
+#include <algorithm>
+
+namespace scenario_conditions
+{
+bool ConditionGroups::add(const boost::shared_ptr<ConditionBase> & condition)
+{
+  if (not condition or not condition->isBatched()) {
+    return false;
+  }
+
+  auto & group = groups_[condition->getType()];
+
+  group.owners.push_back(condition);
+  group.instances.push_back(condition.get());
+  group.active.push_back(true);
+  group.results.reset(new bool[group.instances.size()]());
+
+  return true;
+}
+
+void ConditionGroups::remove(const boost::shared_ptr<ConditionBase> & condition)
+{
+  if (not condition) {
+    return;
+  }
+
+  const auto iter = groups_.find(condition->getType());
+
+  if (iter == groups_.end()) {
+    return;
+  }
+
+  auto & group = iter->second;
+
+  const auto owner = std::find(group.owners.begin(), group.owners.end(), condition);
+
+  if (owner == group.owners.end()) {
+    return;
+  }
+
+  group.instances.erase(group.instances.begin() + (owner - group.owners.begin()));
+  group.active.erase(group.active.begin() + (owner - group.owners.begin()));
+  group.owners.erase(owner);
+
+  if (group.instances.empty()) {
+    groups_.erase(iter);
+  } else {
+    group.results.reset(new bool[group.instances.size()]());
+  }
+}
+
+void ConditionGroups::activate(const boost::shared_ptr<ConditionBase> & condition, bool active)
+{
+  if (not condition) {
+    return;
+  }
+
+  const auto iter = groups_.find(condition->getType());
+
+  if (iter == groups_.end()) {
+    return;
+  }
+
+  auto & group = iter->second;
+
+  const auto owner = std::find(group.owners.begin(), group.owners.end(), condition);
+
+  if (owner != group.owners.end()) {
+    group.active[owner - group.owners.begin()] = active;
+  }
+}
+
+void ConditionGroups::update(const Snapshot & snapshot)
+{
+  for (auto & each : groups_) {
+    auto & group = each.second;
+
+    group.batch.clear();
+
+    for (std::size_t i = 0; i < group.instances.size(); ++i) {
+      if (group.active[i]) {
+        group.batch.push_back(group.instances[i]);
+      }
+    }
+
+    if (group.batch.empty()) {
+      continue;
+    }
+
+    group.batch.front()->updateBatch(group.batch, snapshot, group.results.get());
+
+    for (std::size_t i = 0; i < group.batch.size(); ++i) {
+      group.batch[i]->batched_result_ = group.results[i];
+    }
+  }
+}
+
+}  // namespace scenario_conditions
@@ -1,5 +1,6 @@
 #include "scenario_conditions/condition_visualizer.h"
 #include "scenario_conditions/condition_manager.h"
+#include <scenario_logger/clock.h>
 
 
 namespace scenario_conditions
@@ -31,7 +32,7 @@ void ConditionVisualizer::addMarker(std::string name, bool result, bool is_succe
 {
   visualization_msgs::Marker marker;
   marker.header.frame_id = "base_link";
-  marker.header.stamp = ros::Time::now();
+  marker.header.stamp = scenario_logger::now();
 
   marker.ns = "conditions";
   marker.id = marker_array_.markers.size();
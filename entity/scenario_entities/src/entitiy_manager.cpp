@@ -74,7 +74,10 @@ try
 {
   const auto type { read_essential<std::string>(node, "Type") + "Entity" };
 
-  pluginlib::ClassLoader<scenario_entities::EntityBase> loader("scenario_entities", "scenario_entities::EntityBase");
+  // NOTE: Reading the plugin manifests is expensive, so they are read once per process.
+  static pluginlib::ClassLoader<scenario_entities::EntityBase> loader {
+    "scenario_entities", "scenario_entities::EntityBase"
+  };
   std::vector<std::string> classes = loader.getDeclaredClasses();
 
   const auto iter =
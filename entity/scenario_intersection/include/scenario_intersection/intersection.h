@@ -119,7 +119,7 @@ class Intersection
           if (const auto arrow { each["Arrow"] })
           {
             // NOTE: tag 'Arrow' is deperecated
-            ROS_WARN_STREAM("Tag 'Arrow: <String>' is deperecated. Use 'Arrows: [<String>*]'");
+            SCENARIO_WARN_STREAM(CATEGORY(), "Tag 'Arrow: <String>' is deperecated. Use 'Arrows: [<String>*]'");
             transitions_.emplace_back(each["Id"], each["Color"], arrow);
           }
           else
@@ -0,0 +1,80 @@
+#ifndef SCENARIO_LOGGER_CLOCK_H_INCLUDED
+#define SCENARIO_LOGGER_CLOCK_H_INCLUDED
+
+#include <cstdint>
+#include <functional>
+
+#include <ros/ros.h>
+
+namespace scenario_logger
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * CLOCK
+ *
+ * The one source of "now" for the scenario. While a tick is in progress, the
+ * thread running it sees the timestamp latched at its beginning; this is
+ * cheaper than ros::Time::now() (which locks when use_sim_time is set) and
+ * keeps everything that happens within one tick at the same instant. Outside
+ * of ticks, and on any other thread (e.g. spinners and timers of the APIs,
+ * which must not see a stale tick), the source is read directly.
+ *
+ * The source defaults to ros::Time::now and may be replaced (lockstep
+ * simulation, mocks) before the scenario starts. Reading is thread-safe;
+ * latching is up to the runner.
+ *
+ * -------------------------------------------------------------------------- */
+class Clock
+{
+public:
+  using Source = std::function<ros::Time()>;
+
+  /* ---------------------------------------------------------------------------
+   *
+   * Latches the clock for its lifetime.
+   *
+   * ------------------------------------------------------------------------ */
+  class Tick
+  {
+    Clock& clock_;
+
+  public:
+    explicit Tick(Clock& clock)
+      : clock_ {clock}
+    {
+      clock_.latch();
+    }
+
+    ~Tick()
+    {
+      clock_.unlatch();
+    }
+
+    Tick(const Tick&) = delete;
+    Tick& operator=(const Tick&) = delete;
+  };
+
+  Clock();
+
+  ros::Time now() const;
+
+  void latch();
+  void unlatch() noexcept;
+
+  void setSource(const Source&);
+
+private:
+  Source source_;
+};
+
+Clock& clock();
+
+inline ros::Time now()
+{
+  return clock().now();
+}
+
+}  // namespace scenario_logger
+
+#endif  // SCENARIO_LOGGER_CLOCK_H_INCLUDED
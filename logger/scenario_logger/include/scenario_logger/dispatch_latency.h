@@ -0,0 +1,107 @@
+#ifndef SCENARIO_LOGGER_DISPATCH_LATENCY_H_INCLUDED
+#define SCENARIO_LOGGER_DISPATCH_LATENCY_H_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace scenario_logger
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * DISPATCH LATENCY
+ *
+ * How long it takes from a tick in which an event is ready to fire to its
+ * actions having been run, in stages:
+ *
+ *   tick      from when the tick was due to when it began (starvation)
+ *   update    from the beginning of the tick to the event found ready in
+ *             Event::update (entities, conditions and earlier storylines)
+ *   dispatch  from then to the beginning of the action's run (actor selection
+ *             and the actions before it in the event)
+ *   run       the action's run, including its calls of the ScenarioAPI
+ *   total     all of the above
+ *
+ * Every firing is written to the log, and the stages are aggregated per action
+ * type for the log metadata (toJson). Actions given Delay or Period are run by
+ * the timer wheel later, which is not dispatch, and are not measured. The
+ * backends do not acknowledge the ScenarioAPI calls, so the time until an
+ * effect is seen in the simulation is not measured either.
+ *
+ * -------------------------------------------------------------------------- */
+class DispatchLatency
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  class Firing
+  {
+    DispatchLatency* latency_;
+
+    std::string event_;
+
+    double tick_, update_;  // [s]
+
+    Clock::time_point ready_;
+
+    struct Dispatched
+    {
+      std::string action;
+      double dispatch, run;  // [s]
+    };
+
+    std::vector<Dispatched> dispatched_;
+
+  public:
+    Firing() noexcept;  // NOTE: Measures nothing.
+    Firing(DispatchLatency&, const std::string& event, Clock::time_point ready);
+    Firing(Firing&&) noexcept;
+    Firing(const Firing&) = delete;
+    ~Firing();  // NOTE: Writes the firing to the log.
+
+    void dispatched(const std::string& action, Clock::time_point begin, Clock::time_point end = Clock::now());
+  };
+
+  DispatchLatency();
+
+  // NOTE: At the beginning of every tick, `lag` [s] after it was due.
+  void tick(double lag, Clock::time_point begin = Clock::now());
+
+  Firing fire(const std::string& event, Clock::time_point ready = Clock::now());
+
+  boost::property_tree::ptree toJson() const;
+
+private:
+  struct Stage
+  {
+    double sum { 0 }, max { 0 };  // [s]
+
+    void add(double);
+
+    boost::property_tree::ptree toJson(std::size_t count) const;
+  };
+
+  struct Aggregate
+  {
+    std::size_t count { 0 };
+
+    Stage tick, update, dispatch, run, total;
+  };
+
+  double tick_lag_;  // [s]
+
+  Clock::time_point tick_begin_;
+
+  std::size_t firings_;
+
+  std::map<std::string, Aggregate> aggregates_;  // by action type
+};
+
+}  // namespace scenario_logger
+
+#endif  // SCENARIO_LOGGER_DISPATCH_LATENCY_H_INCLUDED
@@ -0,0 +1,77 @@
+#ifndef SCENARIO_LOGGER_FLOOD_CONTROL_H_INCLUDED
+#define SCENARIO_LOGGER_FLOOD_CONTROL_H_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+namespace scenario_logger
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * FLOOD CONTROL
+ *
+ * Deduplication and rate limiting of the messages of SCENARIO_*_STREAM, keyed
+ * by call site (file:line, or the site given to SCENARIO_*_STREAM_FROM) and
+ * message template (the message with every number replaced by '#'). Within a window, a call site emits at most `burst`
+ * messages and each template of it at most `repeat` times; the rest are only
+ * counted. The count is reported with the next message the call site emits,
+ * or by flush() when the log is written.
+ *
+ * -------------------------------------------------------------------------- */
+class FloodControl
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit FloodControl(double window = 1.0, std::size_t burst = 20, std::size_t repeat = 3);
+
+  void configure(double window, std::size_t burst, std::size_t repeat);
+
+  /* NOTE: Returns the message to be emitted, with the number of suppressed
+   * messages appended if any, or none if the message is to be suppressed. */
+  boost::optional<std::string> admit(const std::string& from, const std::string& message);
+
+  /* NOTE: Returns and clears the counts not reported yet, by call site. */
+  std::vector<std::pair<std::string, std::size_t>> flush();
+
+  std::size_t suppressed() const;
+
+  boost::property_tree::ptree toJson() const;
+
+  static std::string templateOf(const std::string& message);
+
+private:
+  struct Site
+  {
+    Clock::time_point begin;
+
+    std::size_t emitted { 0 };
+
+    std::unordered_map<std::string, std::size_t> templates;  // emitted in the window
+
+    std::size_t pending { 0 };  // suppressed, not reported yet
+
+    std::size_t total { 0 };  // suppressed since start
+  };
+
+  mutable std::mutex mutex_;
+
+  Clock::duration window_;
+
+  std::size_t burst_, repeat_;
+
+  std::unordered_map<std::string, Site> sites_;
+};
+
+}  // namespace scenario_logger
+
+#endif  // SCENARIO_LOGGER_FLOOD_CONTROL_H_INCLUDED
@@ -1,15 +1,24 @@
 #ifndef SCENARIO_LOGGER_LOGGER_H_INCLUDED
 #define SCENARIO_LOGGER_LOGGER_H_INCLUDED
 
+#include <atomic>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/optional.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <cstdint>
 #include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <new>
 #include <ros/ros.h>
+#include <scenario_logger/clock.h>
+#include <scenario_logger/flood_control.h>
 #include <scenario_logger_msgs/LoggedData.h>
 #include <sstream>
+#include <vector>
 
 #define SCENARIO_LOG_FROM \
   std::string(__FILE__) + ":" + std::to_string(__LINE__)
@@ -30,20 +39,44 @@
   SCENARIO_LOG_APPEND( \
     scenario_logger_msgs::Level::LEVEL_LOG, CATEGORY, __VA_ARGS__)
 
+/* NOTE: Flood controlled (see FloodControl), for both the log and the console,
+ * as the call site FROM. Helpers logging for their callers (e.g. the parsers
+ * of scenario_utility) give a site of their own to each thing they log about,
+ * so that unrelated messages are not suppressed as one flood. */
+#define SCENARIO_LOG_APPEND_AND_PRINT_FROM(LEVEL, ROS_STREAM, CATEGORY, FROM, ...) \
+  do                                                                           \
+  {                                                                            \
+    std::stringstream ss {};                                                   \
+    ss << __VA_ARGS__;                                                         \
+    const std::string from { FROM };                                           \
+    const auto admitted { scenario_logger::log.admit(from, ss.str()) };        \
+    if (admitted)                                                              \
+    {                                                                          \
+      scenario_logger::log.append(LEVEL, CATEGORY, *admitted, from);           \
+      ROS_STREAM(*admitted);                                                   \
+    }                                                                          \
+  }                                                                            \
+  while (false)
+
+#define SCENARIO_LOG_APPEND_AND_PRINT(LEVEL, ROS_STREAM, CATEGORY, ...) \
+  SCENARIO_LOG_APPEND_AND_PRINT_FROM( \
+    LEVEL, ROS_STREAM, CATEGORY, SCENARIO_LOG_FROM, __VA_ARGS__)
+
 #define SCENARIO_INFO_STREAM(CATEGORY, ...) \
-  SCENARIO_LOG_APPEND( \
-    scenario_logger_msgs::Level::LEVEL_INFO, CATEGORY, __VA_ARGS__); \
-  ROS_INFO_STREAM(__VA_ARGS__)
+  SCENARIO_LOG_APPEND_AND_PRINT( \
+    scenario_logger_msgs::Level::LEVEL_INFO, ROS_INFO_STREAM, CATEGORY, __VA_ARGS__)
 
 #define SCENARIO_WARN_STREAM(CATEGORY, ...) \
-  SCENARIO_LOG_APPEND( \
-    scenario_logger_msgs::Level::LEVEL_WARN, CATEGORY, __VA_ARGS__); \
-  ROS_WARN_STREAM(__VA_ARGS__)
+  SCENARIO_LOG_APPEND_AND_PRINT( \
+    scenario_logger_msgs::Level::LEVEL_WARN, ROS_WARN_STREAM, CATEGORY, __VA_ARGS__)
 
 #define SCENARIO_ERROR_STREAM(CATEGORY, ...) \
-  SCENARIO_LOG_APPEND( \
-    scenario_logger_msgs::Level::LEVEL_ERROR, CATEGORY, __VA_ARGS__); \
-  ROS_ERROR_STREAM(__VA_ARGS__)
+  SCENARIO_LOG_APPEND_AND_PRINT( \
+    scenario_logger_msgs::Level::LEVEL_ERROR, ROS_ERROR_STREAM, CATEGORY, __VA_ARGS__)
+
+#define SCENARIO_WARN_STREAM_FROM(CATEGORY, FROM, ...) \
+  SCENARIO_LOG_APPEND_AND_PRINT_FROM( \
+    scenario_logger_msgs::Level::LEVEL_WARN, ROS_WARN_STREAM, CATEGORY, FROM, __VA_ARGS__)
 
 #define SCENARIO_ERROR_THROW(CATEGORY, ...)                                    \
   do                                                                           \
@@ -117,16 +150,50 @@ boost::property_tree::ptree toJson(const scenario_logger_msgs::MetaData& data);
 boost::property_tree::ptree toJson(const scenario_logger_msgs::LoggedData& data);
 boost::optional<boost::property_tree::ptree> toJson(const scenario_logger_msgs::Log& data);
 
+/* -----------------------------------------------------------------------------
+ *
+ * Every thread appends to its own buffer, so SCENARIO_*_STREAM may be used from
+ * AsyncSpinner callbacks or worker threads without locking. Each buffer is a
+ * single-producer single-consumer list of fixed size chunks; the writer drains
+ * all buffers and merges them into the log in the order they were appended,
+ * which is kept by a sequence number since the elapsed time of the simulation
+ * may go backwards.
+ *
+ * Taking the sequence number is the only atomic read-modify-write of an
+ * append; the slot is then published by a flag of its own.
+ *
+ * -------------------------------------------------------------------------- */
 class Logger
 {
+  class Buffer;
+
   scenario_logger_msgs::LoggedData data_;
 
   boost::optional<std::string> log_output_path_;
 
   ros::Time time_;
 
+  mutable std::mutex buffers_mutex_;
+
+  std::vector<std::shared_ptr<Buffer>> buffers_;
+
+  std::atomic<std::uint64_t> sequence_;
+
+  mutable std::mutex metadata_mutex_;
+
+  boost::property_tree::ptree metadata_;
+
+  std::map<std::string, std::function<boost::property_tree::ptree()>> metadata_providers_;
+
+  FloodControl flood_control_;
+
+  Buffer& buffer();
+
+  void drain();
+
 public:
   Logger();
+  ~Logger();
 
   void setStartDatetime(const ros::Time&);
   void setScenarioID(const std::string&);
@@ -138,6 +205,7 @@ public:
   void write();
 
   void append(const scenario_logger_msgs::Log&);
+  void append(scenario_logger_msgs::Log&&);
   void append(int level,
               const std::vector<std::string>& categories,
               const std::string& description,
@@ -145,6 +213,27 @@ public:
 
   std::size_t getNumberOfLog() const;
 
+  /* ---------------------------------------------------------------------------
+   *
+   * Flood control of SCENARIO_{INFO,WARN,ERROR}_STREAM (see FloodControl).
+   * The counts of suppressed messages are written to "metadata.suppressed_logs"
+   * by call site.
+   *
+   * ------------------------------------------------------------------------ */
+  boost::optional<std::string> admit(const std::string& from, const std::string& message);
+  void configureFloodControl(double window, std::size_t burst, std::size_t repeat);
+
+  /* ---------------------------------------------------------------------------
+   *
+   * Additional metadata is merged into "metadata" of the output at the given
+   * path (dot separated). A provider is called when the log is written, so the
+   * owner of the data must reset it before it goes away.
+   *
+   * ------------------------------------------------------------------------ */
+  void setMetadata(const std::string& path, const boost::property_tree::ptree&);
+  void setMetadataProvider(const std::string& path, const std::function<boost::property_tree::ptree()>&);
+  void resetMetadataProvider(const std::string& path);
+
   void updateMoveDistance(float move_distance);
 };
 
@@ -0,0 +1,90 @@
+#ifndef SCENARIO_LOGGER_PERF_COUNTERS_H_INCLUDED
+#define SCENARIO_LOGGER_PERF_COUNTERS_H_INCLUDED
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace scenario_logger
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * PERF COUNTERS
+ *
+ * Hardware counters (cycles, instructions, cache misses and branch misses) of
+ * the constructing thread, opened as one perf_event group so that a single
+ * read(2) samples all of them consistently. Measurements are aggregated per
+ * name; each aggregate also carries wall time, so that something useful is
+ * recorded even where the counters are unavailable (containers, VMs without
+ * PMU passthrough, perf_event_paranoid > 2).
+ *
+ * Only measure on the thread that constructed the counters.
+ *
+ * -------------------------------------------------------------------------- */
+class PerfCounters
+{
+public:
+  enum Event
+  {
+    cycles,
+    instructions,
+    cache_misses,
+    branch_misses,
+    number_of_events,
+  };
+
+  using Values = std::array<std::uint64_t, number_of_events>;
+
+  struct Aggregate
+  {
+    std::uint64_t count { 0 };
+    std::chrono::nanoseconds wall_time { 0 };
+    Values values {};
+  };
+
+  class Scope
+  {
+    PerfCounters* counters_;
+    Aggregate* aggregate_;
+    std::chrono::steady_clock::time_point start_;
+    Values values_;
+
+  public:
+    Scope() noexcept;
+    Scope(PerfCounters&, Aggregate&);
+    Scope(Scope&&) noexcept;
+    Scope(const Scope&) = delete;
+    ~Scope();
+  };
+
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  bool available(Event) const noexcept;
+
+  Scope measure(const std::string& name);
+
+  boost::property_tree::ptree toJson() const;
+
+private:
+  bool read(Values&) const noexcept;
+
+  int leader_;
+  std::array<int, number_of_events> descriptors_;
+  std::array<int, number_of_events> positions_;  // index in the group read, or -1
+  int opened_;
+
+  std::unordered_map<std::string, Aggregate> aggregates_;
+};
+
+}  // namespace scenario_logger
+
+#endif  // SCENARIO_LOGGER_PERF_COUNTERS_H_INCLUDED
@@ -0,0 +1,106 @@
+#ifndef SCENARIO_LOGGER_TICK_WATCHDOG_H_INCLUDED
+#define SCENARIO_LOGGER_TICK_WATCHDOG_H_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace scenario_logger
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * TICK WATCHDOG
+ *
+ * Measures the wall time of every tick against a budget. After a tick overran
+ * it, the following ticks are degraded until `hold` ticks in a row kept the
+ * budget again, and the load enabled in the policy is shed meanwhile:
+ *
+ *   low_priority   predicates given `Priority: Low` keep their last result,
+ *                  for at most `max_deferral` ticks in a row
+ *   telemetry      progress reports are coalesced to one per second
+ *
+ * Every degraded tick is counted and the periods of degradation are recorded
+ * for the log metadata (toJson), so that results of overloaded runs can be
+ * told apart.
+ *
+ * -------------------------------------------------------------------------- */
+class TickWatchdog
+{
+public:
+  using wall_clock = std::chrono::steady_clock;
+
+  enum Shedding
+  {
+    low_priority = 1 << 0,
+    telemetry = 1 << 1,
+  };
+
+  static unsigned parse(const std::vector<std::string>& policy);
+
+  explicit TickWatchdog(
+    double budget = 0.01,  // [s] wall time per tick
+    unsigned policy = low_priority | telemetry,
+    std::size_t hold = 10,           // [ticks] on budget before recovery
+    std::size_t max_deferral = 10);  // [ticks] a predicate is deferred in a row at most
+
+  void begin(wall_clock::time_point wall = wall_clock::now());
+
+  void end(double sim_time, wall_clock::time_point wall = wall_clock::now());  // [s] since start
+
+  bool degraded() const noexcept
+  {
+    return degraded_;
+  }
+
+  bool sheds(Shedding shedding) const noexcept
+  {
+    return degraded_ and (policy_ & shedding);
+  }
+
+  /* NOTE: Whether to skip the evaluation of a low-priority predicate in this
+   * tick. `deferred` is the number of ticks the predicate was skipped in a
+   * row, owned by the predicate. */
+  bool defer(std::size_t& deferred);
+
+  /* NOTE: Whether a telemetry report is to be sent now, or coalesced into
+   * the next one. */
+  bool report(wall_clock::time_point wall = wall_clock::now());
+
+  boost::property_tree::ptree toJson() const;
+
+private:
+  struct Period
+  {
+    double begin, end;  // [s] simulation time
+    std::size_t ticks;
+    double longest_tick;  // [s] wall time
+  };
+
+  static constexpr std::size_t max_periods { 1000 };
+
+  const double budget_;
+  const unsigned policy_;
+  const std::size_t hold_;
+  const std::size_t max_deferral_;
+
+  wall_clock::time_point tick_begin_, reported_;
+
+  bool degraded_;
+  std::size_t on_budget_;  // ticks in a row since the last overrun
+
+  std::size_t ticks_, overruns_, degraded_ticks_;
+  double longest_tick_;
+
+  std::size_t deferred_predicates_, coalesced_reports_;
+
+  std::vector<Period> periods_;
+  std::size_t dropped_periods_;
+};
+
+}  // namespace scenario_logger
+
+#endif  // SCENARIO_LOGGER_TICK_WATCHDOG_H_INCLUDED
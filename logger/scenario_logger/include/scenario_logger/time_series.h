@@ -0,0 +1,168 @@
+#ifndef SCENARIO_LOGGER_TIME_SERIES_H_INCLUDED
+#define SCENARIO_LOGGER_TIME_SERIES_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scenario_logger
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * TIME SERIES
+ *
+ * Columnar recording of per-tick values, one file per run. All columns are
+ * doubles; strings (e.g. entity names) are interned and stored as indices into
+ * a name table.
+ *
+ *   Header
+ *   Column names      column_count x char[32]
+ *   Block...          BlockHeader, zone map (min, max, has NaN per column),
+ *                     then each column as rows x double, then the names
+ *                     interned since the previous block as (length (uint32),
+ *                     bytes)..., padded to 8 bytes
+ *   Trailer           end of the blocks, number of blocks, magic
+ *
+ * Blocks are written as they fill, with the names their rows refer to, so a
+ * run that is killed loses at most one block: without the trailer, readers
+ * take the blocks that were written completely. The zone maps let readers
+ * skip blocks that cannot satisfy a predicate without touching their columns.
+ *
+ * -------------------------------------------------------------------------- */
+namespace time_series
+{
+
+constexpr char magic[8] { 'S', 'C', 'N', 'T', 'S', 'E', 'R', 'S' };
+
+constexpr std::uint32_t format_version { 3 };
+
+constexpr std::size_t column_name_size { 32 };
+
+struct Header
+{
+  char magic[8];
+  std::uint32_t format_version;
+  std::uint32_t column_count;
+  std::uint32_t block_rows;  // capacity of a block
+  std::uint32_t reserved;
+};
+
+struct BlockHeader
+{
+  std::uint32_t rows;
+  std::uint32_t names;  // interned since the previous block
+};
+
+struct Zone
+{
+  double min, max;  // of the values other than NaN
+  std::uint32_t has_nan;
+  std::uint32_t reserved;
+};
+
+struct Trailer
+{
+  std::uint64_t blocks_end;
+  std::uint64_t block_count;
+  char magic[8];
+};
+
+}  // namespace time_series
+
+class TimeSeriesWriter
+{
+public:
+  TimeSeriesWriter(
+    const std::string& path, const std::vector<std::string>& columns, std::size_t block_rows = 4096);
+
+  ~TimeSeriesWriter();
+
+  TimeSeriesWriter(const TimeSeriesWriter&) = delete;
+  TimeSeriesWriter& operator=(const TimeSeriesWriter&) = delete;
+
+  double intern(const std::string& name);
+
+  void append(const double* row);  // one value per column
+
+  void close();
+
+private:
+  void flush();
+
+  std::ofstream ofs_;
+
+  const std::size_t column_count_;
+  const std::size_t block_rows_;
+
+  std::vector<double> block_;  // column-major, block_rows_ per column
+  std::size_t rows_;
+  std::uint64_t block_count_;
+
+  std::unordered_map<std::string, std::uint32_t> indices_;
+  std::vector<std::string> names_;
+  std::size_t names_written_;
+};
+
+/* -----------------------------------------------------------------------------
+ *
+ * Read-only view of a time series file (memory mapped). Scans pass only the
+ * requested columns of the rows that satisfy all predicates to the visitor.
+ *
+ * -------------------------------------------------------------------------- */
+class TimeSeriesReader
+{
+public:
+  struct Predicate
+  {
+    enum Operator { less, less_equal, greater, greater_equal, equal, not_equal } op;
+
+    std::size_t column;
+
+    double value;
+  };
+
+  // columns: values of the projected columns, in the requested order
+  using Visitor = std::function<void(const double* columns)>;
+
+  explicit TimeSeriesReader(const std::string& path);
+
+  ~TimeSeriesReader();
+
+  TimeSeriesReader(const TimeSeriesReader&) = delete;
+  TimeSeriesReader& operator=(const TimeSeriesReader&) = delete;
+
+  const std::vector<std::string>& columns() const noexcept { return columns_; }
+  const std::vector<std::string>& names() const noexcept { return names_; }
+
+  bool column(const std::string& name, std::size_t& index) const;
+  bool name(const std::string& name, double& index) const;
+
+  std::size_t scan(
+    const std::vector<std::size_t>& projection,
+    const std::vector<Predicate>& predicates,
+    const Visitor& visit) const;
+
+private:
+  struct Block
+  {
+    std::size_t rows;
+    const time_series::Zone* zones;
+    const double* columns;  // column-major
+  };
+
+  const char* data_;
+  std::size_t size_;
+
+  std::vector<std::string> columns_;
+  std::vector<std::string> names_;
+  std::vector<Block> blocks_;
+};
+
+}  // namespace scenario_logger
+
+#endif  // SCENARIO_LOGGER_TIME_SERIES_H_INCLUDED
@@ -0,0 +1,47 @@
+#include <scenario_logger/clock.h>
+
+namespace scenario_logger
+{
+
+namespace
+{
+
+// NOTE: Per thread, so that only the thread running the tick sees its latch.
+thread_local const Clock* latching { nullptr };
+
+thread_local ros::Time latched {};
+
+}  // namespace
+
+Clock::Clock()
+  : source_ {[]() { return ros::Time::now(); }}
+{}
+
+ros::Time Clock::now() const
+{
+  return latching == this ? latched : source_();
+}
+
+void Clock::latch()
+{
+  latched = source_();
+  latching = this;
+}
+
+void Clock::unlatch() noexcept
+{
+  latching = nullptr;
+}
+
+void Clock::setSource(const Source& source)
+{
+  source_ = source;
+}
+
+Clock& clock()
+{
+  static Clock instance {};  // NOTE: Initialized on first use, so usable from static initializers.
+  return instance;
+}
+
+}  // namespace scenario_logger
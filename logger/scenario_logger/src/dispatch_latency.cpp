@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <sstream>
+
+#include <scenario_logger/dispatch_latency.h>
+#include <scenario_logger/logger.h>
+
+namespace scenario_logger
+{
+
+namespace
+{
+
+double seconds(DispatchLatency::Clock::duration duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+
+}  // namespace
+
+DispatchLatency::Firing::Firing() noexcept
+  : latency_ {nullptr}
+  , tick_ {0}
+  , update_ {0}
+{}
+
+DispatchLatency::Firing::Firing(DispatchLatency& latency, const std::string& event, Clock::time_point ready)
+  : latency_ {&latency}
+  , event_ {event}
+  , tick_ {latency.tick_lag_}
+  , update_ {seconds(ready - latency.tick_begin_)}
+  , ready_ {ready}
+{
+  ++latency.firings_;
+}
+
+DispatchLatency::Firing::Firing(Firing&& rhs) noexcept
+  : latency_ {rhs.latency_}
+  , event_ {std::move(rhs.event_)}
+  , tick_ {rhs.tick_}
+  , update_ {rhs.update_}
+  , ready_ {rhs.ready_}
+  , dispatched_ {std::move(rhs.dispatched_)}
+{
+  rhs.latency_ = nullptr;
+}
+
+DispatchLatency::Firing::~Firing()
+{
+  if (latency_ and not dispatched_.empty())
+  {
+    std::stringstream ss {};
+
+    ss << "Event " << event_ << " fired: tick " << tick_ << " [s], update " << update_ << " [s]";
+
+    for (const auto& each : dispatched_)
+    {
+      ss << ", " << each.action << " dispatch " << each.dispatch << " [s] run " << each.run << " [s]";
+    }
+
+    SCENARIO_LOG_STREAM(CATEGORY("simulation", "latency"), ss.str());
+  }
+}
+
+void DispatchLatency::Firing::dispatched(
+  const std::string& action, Clock::time_point begin, Clock::time_point end)
+{
+  if (latency_)
+  {
+    dispatched_.push_back({ action, seconds(begin - ready_), seconds(end - begin) });
+
+    auto& aggregate { latency_->aggregates_[action] };
+
+    ++aggregate.count;
+    aggregate.tick.add(tick_);
+    aggregate.update.add(update_);
+    aggregate.dispatch.add(dispatched_.back().dispatch);
+    aggregate.run.add(dispatched_.back().run);
+    aggregate.total.add(tick_ + update_ + dispatched_.back().dispatch + dispatched_.back().run);
+  }
+}
+
+void DispatchLatency::Stage::add(double value)
+{
+  sum += value;
+  max = std::max(max, value);
+}
+
+boost::property_tree::ptree DispatchLatency::Stage::toJson(std::size_t count) const
+{
+  boost::property_tree::ptree tree {};
+
+  tree.put("mean", count ? sum / count : 0);
+  tree.put("max", max);
+
+  return tree;
+}
+
+DispatchLatency::DispatchLatency()
+  : tick_lag_ {0}
+  , tick_begin_ {Clock::now()}
+  , firings_ {0}
+{}
+
+void DispatchLatency::tick(double lag, Clock::time_point begin)
+{
+  tick_lag_ = std::max(lag, 0.0);
+  tick_begin_ = begin;
+}
+
+DispatchLatency::Firing DispatchLatency::fire(const std::string& event, Clock::time_point ready)
+{
+  return Firing(*this, event, ready);
+}
+
+boost::property_tree::ptree DispatchLatency::toJson() const
+{
+  boost::property_tree::ptree tree {};
+
+  tree.put("firings", firings_);
+
+  boost::property_tree::ptree actions {};
+
+  for (const auto& each : aggregates_)
+  {
+    boost::property_tree::ptree action {};
+
+    action.put("count", each.second.count);
+    action.add_child("tick", each.second.tick.toJson(each.second.count));
+    action.add_child("update", each.second.update.toJson(each.second.count));
+    action.add_child("dispatch", each.second.dispatch.toJson(each.second.count));
+    action.add_child("run", each.second.run.toJson(each.second.count));
+    action.add_child("total", each.second.total.toJson(each.second.count));
+
+    // NOTE: Not put_child(), which would take dots in the type as a path.
+    actions.push_back(std::make_pair(each.first, action));
+  }
+
+  tree.add_child("actions", actions);
+
+  return tree;
+}
+
+}  // namespace scenario_logger
@@ -0,0 +1,138 @@
+#include <cctype>
+
+#include <scenario_logger/flood_control.h>
+
+namespace scenario_logger
+{
+
+FloodControl::FloodControl(double window, std::size_t burst, std::size_t repeat)
+{
+  configure(window, burst, repeat);
+}
+
+void FloodControl::configure(double window, std::size_t burst, std::size_t repeat)
+{
+  std::lock_guard<std::mutex> lock { mutex_ };
+
+  window_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(window));
+  burst_ = burst;
+  repeat_ = repeat;
+}
+
+std::string FloodControl::templateOf(const std::string& message)
+{
+  std::string result {};
+
+  result.reserve(message.size());
+
+  for (auto iter { message.begin() }; iter != message.end(); )
+  {
+    if (std::isdigit(static_cast<unsigned char>(*iter)))
+    {
+      // NOTE: A run of digits with decimal points in between, e.g. 1, 42 or 3.14.
+      while (iter != message.end() and (std::isdigit(static_cast<unsigned char>(*iter)) or *iter == '.'))
+      {
+        ++iter;
+      }
+
+      result.push_back('#');
+    }
+    else
+    {
+      result.push_back(*iter++);
+    }
+  }
+
+  return result;
+}
+
+boost::optional<std::string> FloodControl::admit(const std::string& from, const std::string& message)
+{
+  const auto now { Clock::now() };
+
+  std::lock_guard<std::mutex> lock { mutex_ };
+
+  auto& site { sites_[from] };
+
+  if (site.begin + window_ <= now)
+  {
+    site.begin = now;
+    site.emitted = 0;
+    site.templates.clear();
+  }
+
+  // NOTE: Templates are only looked up while the call site is under its burst, which bounds the map.
+  if (burst_ <= site.emitted or repeat_ < ++site.templates[templateOf(message)])
+  {
+    ++site.pending;
+    ++site.total;
+    return boost::none;
+  }
+
+  ++site.emitted;
+
+  if (site.pending)
+  {
+    const auto pending { site.pending };
+    site.pending = 0;
+    return message + " [" + std::to_string(pending) + " similar messages suppressed]";
+  }
+  else
+  {
+    return message;
+  }
+}
+
+std::vector<std::pair<std::string, std::size_t>> FloodControl::flush()
+{
+  std::lock_guard<std::mutex> lock { mutex_ };
+
+  std::vector<std::pair<std::string, std::size_t>> result {};
+
+  for (auto& each : sites_)
+  {
+    if (each.second.pending)
+    {
+      result.emplace_back(each.first, each.second.pending);
+      each.second.pending = 0;
+    }
+  }
+
+  return result;
+}
+
+std::size_t FloodControl::suppressed() const
+{
+  std::lock_guard<std::mutex> lock { mutex_ };
+
+  std::size_t result { 0 };
+
+  for (const auto& each : sites_)
+  {
+    result += each.second.total;
+  }
+
+  return result;
+}
+
+boost::property_tree::ptree FloodControl::toJson() const
+{
+  std::lock_guard<std::mutex> lock { mutex_ };
+
+  boost::property_tree::ptree result {};
+
+  for (const auto& each : sites_)
+  {
+    if (each.second.total)
+    {
+      // NOTE: Not put(), which would take the dots of the file name as a path.
+      boost::property_tree::ptree count {};
+      count.put_value(each.second.total);
+      result.push_back(std::make_pair(each.first, count));
+    }
+  }
+
+  return result;
+}
+
+}  // namespace scenario_logger
@@ -1,8 +1,109 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <scenario_logger/logger.h>
 
 namespace scenario_logger
 {
 
+class Logger::Buffer
+{
+  using Log = scenario_logger_msgs::Log;
+
+  static constexpr std::size_t capacity { 128 };
+
+  // NOTE: Raw storage, as default constructing 128 logs per chunk would cost more than appending them.
+  struct Chunk
+  {
+    typename std::aligned_storage<sizeof(Log), alignof(Log)>::type logs[capacity];
+
+    std::array<std::uint64_t, capacity> sequences;
+
+    std::array<std::atomic<bool>, capacity> ready {};  // constructed, not consumed yet
+
+    std::atomic<Chunk*> next { nullptr };
+
+    Log& operator[](std::size_t index) noexcept
+    {
+      return reinterpret_cast<Log&>(logs[index]);
+    }
+  };
+
+  Chunk* front_; // owned by the consumer (writer)
+
+  std::size_t read_;
+
+  Chunk* back_; // owned by the producer (appending thread)
+
+  std::size_t written_;
+
+public:
+  Buffer()
+    : front_ { new Chunk() }
+    , read_ { 0 }
+    , back_ { front_ }
+    , written_ { 0 }
+  {}
+
+  ~Buffer()
+  {
+    while (front_)
+    {
+      for (; read_ < capacity and front_->ready[read_].load(std::memory_order_acquire); ++read_)
+      {
+        (*front_)[read_].~Log();
+      }
+
+      delete std::exchange(front_, front_->next.load(std::memory_order_acquire));
+      read_ = 0;
+    }
+  }
+
+  void push(std::uint64_t sequence, Log&& log)
+  {
+    if (written_ == capacity)
+    {
+      auto* const chunk { new Chunk() };
+      back_->next.store(chunk, std::memory_order_release);
+      back_ = chunk;
+      written_ = 0;
+    }
+
+    new (&(*back_)[written_]) Log(std::move(log));
+    back_->sequences[written_] = sequence;
+    back_->ready[written_++].store(true, std::memory_order_release);
+  }
+
+  template <typename F>
+  void consume(F&& f)
+  {
+    while (true)
+    {
+      for (; read_ < capacity and front_->ready[read_].load(std::memory_order_acquire); ++read_)
+      {
+        auto& log { (*front_)[read_] };
+        f(front_->sequences[read_], std::move(log));
+        log.~Log();
+      }
+
+      if (read_ == capacity)
+      {
+        if (auto* const next { front_->next.load(std::memory_order_acquire) })
+        {
+          delete std::exchange(front_, next);
+          read_ = 0;
+          continue;
+        }
+      }
+
+      return;
+    }
+  }
+};
+
 static int schwarz_counter { 0 };
 
 static typename std::aligned_storage<sizeof(Logger), alignof(Logger)>::type memory;
@@ -28,8 +129,59 @@ LoggerInitializer::~LoggerInitializer()
 Logger::Logger()
   : data_ {}
   , log_output_path_ { boost::none }
+  , sequence_ { 0 }
 {}
 
+Logger::~Logger() = default;
+
+Logger::Buffer& Logger::buffer()
+{
+  // NOTE: The registry keeps the buffer alive after its thread exits, so nothing appended is lost.
+  thread_local std::shared_ptr<Buffer> local { nullptr };
+
+  if (not local)
+  {
+    local = std::make_shared<Buffer>();
+
+    std::lock_guard<std::mutex> lock { buffers_mutex_ };
+    buffers_.push_back(local);
+  }
+
+  return *local;
+}
+
+void Logger::drain()
+{
+  std::lock_guard<std::mutex> lock { buffers_mutex_ };
+
+  std::vector<std::pair<std::uint64_t, scenario_logger_msgs::Log>> logs {};
+
+  const auto earlier = [](const auto& lhs, const auto& rhs)
+  {
+    return lhs.first < rhs.first;
+  };
+
+  for (const auto& each : buffers_)
+  {
+    const auto drained { logs.size() };
+
+    (*each).consume([&](auto sequence, auto&& log)
+    {
+      logs.emplace_back(sequence, std::move(log));
+    });
+
+    // NOTE: Entries of a single thread are already in order, so a merge is enough.
+    std::inplace_merge(logs.begin(), logs.begin() + drained, logs.end(), earlier);
+  }
+
+  data_.log.reserve(data_.log.size() + logs.size());
+
+  for (auto&& each : logs)
+  {
+    data_.log.push_back(std::move(each.second));
+  }
+}
+
 void Logger::setStartDatetime(const ros::Time& time)
 {
   data_.metadata.start_datetime = toIso6801(time);
@@ -64,12 +216,42 @@ void Logger::write()
 {
   if (log_output_path_)
   {
-    const ros::Time now { ros::Time::now() };
+    const ros::Time now { clock().now() };
 
     data_.metadata.end_datetime = toIso6801(now);
     data_.metadata.duration = (now - begin()).toSec();
 
-    boost::property_tree::write_json(log_output_path_.get(), toJson(data_));
+    // NOTE: Counts not reported by a later message of the same call site yet.
+    for (const auto& each : flood_control_.flush())
+    {
+      append(scenario_logger_msgs::Level::LEVEL_WARN, CATEGORY(),
+        std::to_string(each.second) + " similar messages suppressed", each.first);
+    }
+
+    drain();
+
+    auto tree { toJson(data_) };
+
+    {
+      std::lock_guard<std::mutex> lock { metadata_mutex_ };
+
+      for (const auto& each : metadata_)
+      {
+        tree.put_child("metadata." + each.first, each.second);
+      }
+
+      for (const auto& each : metadata_providers_)
+      {
+        tree.put_child("metadata." + each.first, each.second());
+      }
+    }
+
+    if (flood_control_.suppressed())
+    {
+      tree.put_child("metadata.suppressed_logs", flood_control_.toJson());
+    }
+
+    boost::property_tree::write_json(log_output_path_.get(), tree);
   }
   else
   {
@@ -77,9 +259,33 @@ void Logger::write()
   }
 }
 
+void Logger::setMetadata(const std::string& path, const boost::property_tree::ptree& tree)
+{
+  std::lock_guard<std::mutex> lock { metadata_mutex_ };
+  metadata_.put_child(path, tree);
+}
+
+void Logger::setMetadataProvider(
+  const std::string& path, const std::function<boost::property_tree::ptree()>& provider)
+{
+  std::lock_guard<std::mutex> lock { metadata_mutex_ };
+  metadata_providers_[path] = provider;
+}
+
+void Logger::resetMetadataProvider(const std::string& path)
+{
+  std::lock_guard<std::mutex> lock { metadata_mutex_ };
+  metadata_providers_.erase(path);
+}
+
 void Logger::append(const scenario_logger_msgs::Log& log)
 {
-  data_.log.push_back(log);
+  buffer().push(sequence_.fetch_add(1, std::memory_order_relaxed), scenario_logger_msgs::Log(log));
+}
+
+void Logger::append(scenario_logger_msgs::Log&& log)
+{
+  buffer().push(sequence_.fetch_add(1, std::memory_order_relaxed), std::move(log));
 }
 
 void Logger::append(int level,
@@ -89,20 +295,31 @@ void Logger::append(int level,
 {
   scenario_logger_msgs::Log log;
 
-  log.elapsed_time = ros::Time::now() - begin();
+  log.elapsed_time = clock().now() - begin();
   log.level.level = level;
   log.categories = categories;
   log.description = description;
   log.from = from;
 
-  append(log);
+  append(std::move(log));
 }
 
 std::size_t Logger::getNumberOfLog() const
 {
-  return data_.log.size();
+  // NOTE: Every append takes a sequence number, so this is the number appended.
+  return sequence_.load(std::memory_order_relaxed);
 };
 
+boost::optional<std::string> Logger::admit(const std::string& from, const std::string& message)
+{
+  return flood_control_.admit(from, message);
+}
+
+void Logger::configureFloodControl(double window, std::size_t burst, std::size_t repeat)
+{
+  flood_control_.configure(window, burst, repeat);
+}
+
 void Logger::updateMoveDistance(float move_distance)
 {
   data_.metadata.move_distance = move_distance;
@@ -0,0 +1,203 @@
+#include <cerrno>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <scenario_logger/logger.h>
+#include <scenario_logger/perf_counters.h>
+
+namespace scenario_logger
+{
+
+namespace
+{
+
+int open(std::uint64_t config, int group)
+{
+  perf_event_attr attr {};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = (group == -1);
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+
+  return static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+constexpr const char* names[] {
+  "cycles", "instructions", "cache_misses", "branch_misses",
+};
+
+}  // namespace
+
+PerfCounters::PerfCounters()
+  : leader_ {-1}
+  , opened_ {0}
+{
+  descriptors_.fill(-1);
+  positions_.fill(-1);
+
+  constexpr std::uint64_t configs[] {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+  };
+
+  // NOTE: Any event may be missing; the first one opened leads the group.
+  for (int event {0}; event < number_of_events; ++event)
+  {
+    const auto descriptor { open(configs[event], leader_) };
+
+    if (descriptor != -1)
+    {
+      if (leader_ == -1)
+      {
+        leader_ = descriptor;
+      }
+
+      descriptors_[event] = descriptor;
+      positions_[event] = opened_++;
+    }
+  }
+
+  if (leader_ == -1)
+  {
+    SCENARIO_WARN_STREAM(CATEGORY(),
+      "Hardware performance counters are unavailable (" << std::strerror(errno) << "). "
+      "Only wall time is measured.");
+  }
+  else
+  {
+    ::ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+}
+
+PerfCounters::~PerfCounters()
+{
+  for (const auto& descriptor : descriptors_)
+  {
+    if (descriptor != -1)
+    {
+      ::close(descriptor);
+    }
+  }
+}
+
+bool PerfCounters::available(Event event) const noexcept
+{
+  return positions_[event] != -1;
+}
+
+bool PerfCounters::read(Values& values) const noexcept
+{
+  if (leader_ == -1)
+  {
+    return false;
+  }
+
+  std::uint64_t buffer[1 + number_of_events] {};  // { nr, values[nr] }
+
+  if (::read(leader_, buffer, sizeof(buffer)) < static_cast<ssize_t>(sizeof(std::uint64_t) * (1 + opened_)))
+  {
+    return false;
+  }
+
+  for (int event {0}; event < number_of_events; ++event)
+  {
+    values[event] = positions_[event] != -1 ? buffer[1 + positions_[event]] : 0;
+  }
+
+  return true;
+}
+
+PerfCounters::Scope PerfCounters::measure(const std::string& name)
+{
+  return Scope { *this, aggregates_[name] };
+}
+
+boost::property_tree::ptree PerfCounters::toJson() const
+{
+  boost::property_tree::ptree tree {};
+
+  for (const auto& each : aggregates_)
+  {
+    boost::property_tree::ptree child {};
+
+    const auto& aggregate { each.second };
+
+    child.put("count", aggregate.count);
+    child.put("wall_time", std::chrono::duration<double>(aggregate.wall_time).count());
+
+    for (int event {0}; event < number_of_events; ++event)
+    {
+      if (available(static_cast<Event>(event)))
+      {
+        child.put(names[event], aggregate.values[event]);
+      }
+    }
+
+    if (available(cycles) and available(instructions) and aggregate.values[cycles])
+    {
+      child.put("instructions_per_cycle",
+        static_cast<double>(aggregate.values[instructions]) / aggregate.values[cycles]);
+    }
+
+    // NOTE: Names may contain dots, which ptree would take as a path.
+    tree.push_back(std::make_pair(each.first, child));
+  }
+
+  return tree;
+}
+
+PerfCounters::Scope::Scope() noexcept
+  : counters_ {nullptr}
+  , aggregate_ {nullptr}
+  , start_ {}
+  , values_ {}
+{}
+
+PerfCounters::Scope::Scope(PerfCounters& counters, Aggregate& aggregate)
+  : counters_ {&counters}
+  , aggregate_ {&aggregate}
+  , start_ {std::chrono::steady_clock::now()}
+  , values_ {}
+{
+  counters_->read(values_);
+}
+
+PerfCounters::Scope::Scope(Scope&& scope) noexcept
+  : counters_ {scope.counters_}
+  , aggregate_ {scope.aggregate_}
+  , start_ {scope.start_}
+  , values_ (scope.values_)
+{
+  scope.counters_ = nullptr;
+}
+
+PerfCounters::Scope::~Scope()
+{
+  if (counters_)
+  {
+    Values values {};
+
+    if (counters_->read(values))
+    {
+      for (int event {0}; event < number_of_events; ++event)
+      {
+        aggregate_->values[event] += values[event] - values_[event];
+      }
+    }
+
+    aggregate_->wall_time += std::chrono::steady_clock::now() - start_;
+    ++aggregate_->count;
+  }
+}
+
+}  // namespace scenario_logger
@@ -0,0 +1,184 @@
+#include <algorithm>
+
+#include <boost/algorithm/string.hpp>
+
+#include <scenario_logger/logger.h>
+#include <scenario_logger/tick_watchdog.h>
+
+namespace scenario_logger
+{
+
+namespace
+{
+
+double seconds(TickWatchdog::wall_clock::duration duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+
+}  // namespace
+
+constexpr std::size_t TickWatchdog::max_periods;
+
+unsigned TickWatchdog::parse(const std::vector<std::string>& policy)
+{
+  unsigned result { 0 };
+
+  for (const auto& each : policy)
+  {
+    if (boost::iequals(each, "low_priority"))
+    {
+      result |= low_priority;
+    }
+    else if (boost::iequals(each, "telemetry"))
+    {
+      result |= telemetry;
+    }
+    else
+    {
+      SCENARIO_ERROR_THROW(CATEGORY(),
+        "Unknown load shedding '" << each << "'. Expected low_priority or telemetry.");
+    }
+  }
+
+  return result;
+}
+
+TickWatchdog::TickWatchdog(double budget, unsigned policy, std::size_t hold, std::size_t max_deferral)
+  : budget_ {budget}
+  , policy_ {policy}
+  , hold_ {hold}
+  , max_deferral_ {max_deferral}
+  , degraded_ {false}
+  , on_budget_ {0}
+  , ticks_ {0}
+  , overruns_ {0}
+  , degraded_ticks_ {0}
+  , longest_tick_ {0}
+  , deferred_predicates_ {0}
+  , coalesced_reports_ {0}
+  , dropped_periods_ {0}
+{}
+
+void TickWatchdog::begin(wall_clock::time_point wall)
+{
+  tick_begin_ = wall;
+}
+
+void TickWatchdog::end(double sim_time, wall_clock::time_point wall)
+{
+  const auto duration { seconds(wall - tick_begin_) };
+
+  ++ticks_;
+
+  longest_tick_ = std::max(longest_tick_, duration);
+
+  if (degraded_)
+  {
+    ++degraded_ticks_;
+
+    if (not periods_.empty())
+    {
+      periods_.back().end = sim_time;
+      ++periods_.back().ticks;
+      periods_.back().longest_tick = std::max(periods_.back().longest_tick, duration);
+    }
+  }
+
+  if (budget_ < duration)
+  {
+    ++overruns_;
+    on_budget_ = 0;
+
+    if (not degraded_)
+    {
+      degraded_ = true;
+
+      SCENARIO_WARN_STREAM(CATEGORY("simulation", "clock"),
+        "Tick took " << duration << " [s] over the budget of " << budget_ << " [s]. Shedding load.");
+
+      if (periods_.size() < max_periods)
+      {
+        periods_.push_back({ sim_time, sim_time, 0, duration });
+      }
+      else
+      {
+        ++dropped_periods_;
+      }
+    }
+  }
+  else if (degraded_ and hold_ <= ++on_budget_)
+  {
+    degraded_ = false;
+
+    SCENARIO_INFO_STREAM(CATEGORY("simulation", "clock"),
+      "Ticks kept the budget of " << budget_ << " [s] again. Stopped shedding load.");
+  }
+}
+
+bool TickWatchdog::defer(std::size_t& deferred)
+{
+  if (sheds(low_priority) and deferred < max_deferral_)
+  {
+    ++deferred;
+    ++deferred_predicates_;
+    return true;
+  }
+  else
+  {
+    deferred = 0;
+    return false;
+  }
+}
+
+bool TickWatchdog::report(wall_clock::time_point wall)
+{
+  if (sheds(telemetry) and wall < reported_ + std::chrono::seconds(1))
+  {
+    ++coalesced_reports_;
+    return false;
+  }
+  else
+  {
+    reported_ = wall;
+    return true;
+  }
+}
+
+boost::property_tree::ptree TickWatchdog::toJson() const
+{
+  boost::property_tree::ptree tree {};
+
+  tree.put("budget", budget_);
+  tree.put("ticks", ticks_);
+  tree.put("overruns", overruns_);
+  tree.put("longest_tick", longest_tick_);
+
+  // NOTE: The flag to look at when judging the results of a run.
+  tree.put("degraded", 0 < degraded_ticks_);
+  tree.put("degraded_ticks", degraded_ticks_);
+
+  tree.put("shed.deferred_predicates", deferred_predicates_);
+  tree.put("shed.coalesced_reports", coalesced_reports_);
+
+  boost::property_tree::ptree periods {};
+
+  for (const auto& each : periods_)
+  {
+    boost::property_tree::ptree period {};
+
+    period.put("begin", each.begin);
+    period.put("end", each.end);
+    period.put("ticks", each.ticks);
+    period.put("longest_tick", each.longest_tick);
+
+    periods.push_back(std::make_pair("", period));
+  }
+
+  tree.add_child("periods", periods);
+  tree.put("dropped_periods", dropped_periods_);
+
+  return tree;
+}
+
+}  // namespace scenario_logger
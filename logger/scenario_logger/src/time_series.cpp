@@ -0,0 +1,415 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <scenario_logger/time_series.h>
+
+namespace scenario_logger
+{
+
+using namespace time_series;
+
+/* ---- WRITER -------------------------------------------------------------- */
+
+TimeSeriesWriter::TimeSeriesWriter(
+  const std::string& path, const std::vector<std::string>& columns, std::size_t block_rows)
+  : ofs_ {path, std::ios::binary | std::ios::trunc}
+  , column_count_ {columns.size()}
+  , block_rows_ {block_rows}
+  , block_(columns.size() * block_rows)
+  , rows_ {0}
+  , block_count_ {0}
+  , names_written_ {0}
+{
+  if (not ofs_)
+  {
+    throw std::runtime_error { "Failed to open time series file \"" + path + "\"." };
+  }
+
+  Header header {};
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.format_version = format_version;
+  header.column_count = column_count_;
+  header.block_rows = block_rows_;
+  ofs_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  for (const auto& each : columns)
+  {
+    char name[column_name_size] {};
+    std::strncpy(name, each.c_str(), sizeof(name) - 1);
+    ofs_.write(name, sizeof(name));
+  }
+}
+
+TimeSeriesWriter::~TimeSeriesWriter()
+{
+  close();
+}
+
+double TimeSeriesWriter::intern(const std::string& name)
+{
+  const auto result { indices_.emplace(name, names_.size()) };
+
+  if (result.second)
+  {
+    names_.push_back(name);
+  }
+
+  return result.first->second;
+}
+
+void TimeSeriesWriter::append(const double* row)
+{
+  for (std::size_t column {0}; column < column_count_; ++column)
+  {
+    block_[column * block_rows_ + rows_] = row[column];
+  }
+
+  if (++rows_ == block_rows_)
+  {
+    flush();
+  }
+}
+
+void TimeSeriesWriter::flush()
+{
+  if (rows_ == 0 or not ofs_.is_open())
+  {
+    return;
+  }
+
+  BlockHeader header {};
+  header.rows = rows_;
+  header.names = names_.size() - names_written_;
+  ofs_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  for (std::size_t column {0}; column < column_count_; ++column)
+  {
+    // NOTE: NaN (missing values) satisfies no ordering, so it is only flagged.
+    Zone zone { std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 0, 0 };
+
+    const auto first { &block_[column * block_rows_] };
+
+    for (auto iter { first }; iter != first + rows_; ++iter)
+    {
+      if (std::isnan(*iter))
+      {
+        zone.has_nan = 1;
+      }
+      else
+      {
+        zone.min = std::min(zone.min, *iter);
+        zone.max = std::max(zone.max, *iter);
+      }
+    }
+
+    ofs_.write(reinterpret_cast<const char*>(&zone), sizeof(zone));
+  }
+
+  for (std::size_t column {0}; column < column_count_; ++column)
+  {
+    ofs_.write(
+      reinterpret_cast<const char*>(&block_[column * block_rows_]), sizeof(double) * rows_);
+  }
+
+  std::size_t size {0};
+
+  for (; names_written_ < names_.size(); ++names_written_)
+  {
+    const auto& each { names_[names_written_] };
+    const std::uint32_t length = each.size();
+    ofs_.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    ofs_.write(each.data(), length);
+    size += sizeof(length) + length;
+  }
+
+  // NOTE: So that the columns of the next block are aligned.
+  const char padding[alignof(double)] {};
+  ofs_.write(padding, (alignof(double) - size % alignof(double)) % alignof(double));
+
+  ofs_.flush();
+
+  rows_ = 0;
+  ++block_count_;
+}
+
+void TimeSeriesWriter::close()
+{
+  if (not ofs_.is_open())
+  {
+    return;
+  }
+
+  flush();
+
+  Trailer trailer {};
+  trailer.blocks_end = ofs_.tellp();
+  trailer.block_count = block_count_;
+  std::memcpy(trailer.magic, magic, sizeof(magic));
+
+  ofs_.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer));
+  ofs_.close();
+}
+
+/* ---- READER -------------------------------------------------------------- */
+
+TimeSeriesReader::TimeSeriesReader(const std::string& path)
+  : data_ {nullptr}
+  , size_ {0}
+{
+  const int fd { ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+
+  if (fd < 0)
+  {
+    throw std::runtime_error { "Failed to open time series file \"" + path + "\"." };
+  }
+
+  struct stat status {};
+
+  if (::fstat(fd, &status) == 0 and 0 < status.st_size)
+  {
+    size_ = status.st_size;
+    void* const mapped { ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0) };
+    data_ = (mapped == MAP_FAILED) ? nullptr : static_cast<const char*>(mapped);
+  }
+
+  ::close(fd);
+
+  // NOTE: The destructor does not run if the constructor throws.
+  const auto invalid = [&]()
+  {
+    if (data_)
+    {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+    return std::runtime_error { "Malformed time series file \"" + path + "\"." };
+  };
+
+  Header header {};
+
+  if (not data_ or size_ < sizeof(header))
+  {
+    throw invalid();
+  }
+
+  std::memcpy(&header, data_, sizeof(header));
+
+  const std::size_t column_count { header.column_count };
+  const auto columns_end { sizeof(header) + column_count * column_name_size };
+
+  if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 or
+      header.format_version != format_version or
+      size_ < columns_end)
+  {
+    throw invalid();
+  }
+
+  // NOTE: No trailer if the run was killed; then the blocks written completely are read.
+  Trailer trailer {};
+
+  const bool closed {
+    columns_end + sizeof(trailer) <= size_ and
+    (std::memcpy(&trailer, data_ + size_ - sizeof(trailer), sizeof(trailer)),
+     std::memcmp(trailer.magic, magic, sizeof(magic)) == 0)
+  };
+
+  if (closed and (trailer.blocks_end < columns_end or size_ - sizeof(trailer) < trailer.blocks_end))
+  {
+    throw invalid();
+  }
+
+  const auto end { closed ? trailer.blocks_end : size_ };
+
+  for (std::size_t column {0}; column < column_count; ++column)
+  {
+    const auto name { data_ + sizeof(header) + column * column_name_size };
+    columns_.emplace_back(name, strnlen(name, column_name_size));
+  }
+
+  auto offset { columns_end };
+
+  while (offset < end)
+  {
+    BlockHeader block_header {};
+
+    if (end < offset + sizeof(block_header))
+    {
+      break;
+    }
+
+    std::memcpy(&block_header, data_ + offset, sizeof(block_header));
+
+    auto next { offset + sizeof(block_header) };
+
+    const auto zones { reinterpret_cast<const Zone*>(data_ + next) };
+    next += sizeof(Zone) * column_count;
+
+    const auto values { reinterpret_cast<const double*>(data_ + next) };
+    next += sizeof(double) * column_count * block_header.rows;
+
+    std::vector<std::string> names {};
+
+    for (std::uint32_t i {0}; i < block_header.names and next <= end; ++i)
+    {
+      std::uint32_t length {};
+
+      if (end < next + sizeof(length))
+      {
+        next = end + 1;
+        break;
+      }
+
+      std::memcpy(&length, data_ + next, sizeof(length));
+      next += sizeof(length);
+
+      if (end < next + length)
+      {
+        next = end + 1;
+        break;
+      }
+
+      names.emplace_back(data_ + next, length);
+      next += length;
+    }
+
+    next += (alignof(double) - next % alignof(double)) % alignof(double);
+
+    if (end < next)
+    {
+      break;  // NOTE: Cut off while written.
+    }
+
+    blocks_.push_back({ block_header.rows, zones, values });
+    names_.insert(names_.end(), names.begin(), names.end());
+
+    offset = next;
+  }
+
+  if (closed and (offset != end or blocks_.size() != trailer.block_count))
+  {
+    throw invalid();
+  }
+}
+
+TimeSeriesReader::~TimeSeriesReader()
+{
+  if (data_)
+  {
+    ::munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+  }
+}
+
+bool TimeSeriesReader::column(const std::string& name, std::size_t& index) const
+{
+  const auto iter { std::find(columns_.begin(), columns_.end(), name) };
+  index = iter - columns_.begin();
+  return iter != columns_.end();
+}
+
+bool TimeSeriesReader::name(const std::string& name, double& index) const
+{
+  const auto iter { std::find(names_.begin(), names_.end(), name) };
+  index = iter - names_.begin();
+  return iter != names_.end();
+}
+
+namespace
+{
+
+bool mayContain(const Zone& zone, const TimeSeriesReader::Predicate& predicate)
+{
+  switch (predicate.op)
+  {
+  case TimeSeriesReader::Predicate::less:          return zone.min <  predicate.value;
+  case TimeSeriesReader::Predicate::less_equal:    return zone.min <= predicate.value;
+  case TimeSeriesReader::Predicate::greater:       return zone.max >  predicate.value;
+  case TimeSeriesReader::Predicate::greater_equal: return zone.max >= predicate.value;
+  case TimeSeriesReader::Predicate::equal:         return zone.min <= predicate.value and predicate.value <= zone.max;
+  case TimeSeriesReader::Predicate::not_equal:     return zone.has_nan or not (zone.min == predicate.value and zone.max == predicate.value);
+  default:
+    return true;
+  }
+}
+
+/* NOTE: One tight loop per operator, so that the compiler vectorizes each. */
+template <typename Compare>
+void filter(const double* values, std::size_t size, double value, std::uint8_t* selection, Compare compare)
+{
+  for (std::size_t i {0}; i < size; ++i)
+  {
+    selection[i] &= compare(values[i], value);
+  }
+}
+
+void filter(const double* values, std::size_t size, const TimeSeriesReader::Predicate& predicate, std::uint8_t* selection)
+{
+  switch (predicate.op)
+  {
+  case TimeSeriesReader::Predicate::less:          return filter(values, size, predicate.value, selection, std::less<double>());
+  case TimeSeriesReader::Predicate::less_equal:    return filter(values, size, predicate.value, selection, std::less_equal<double>());
+  case TimeSeriesReader::Predicate::greater:       return filter(values, size, predicate.value, selection, std::greater<double>());
+  case TimeSeriesReader::Predicate::greater_equal: return filter(values, size, predicate.value, selection, std::greater_equal<double>());
+  case TimeSeriesReader::Predicate::equal:         return filter(values, size, predicate.value, selection, std::equal_to<double>());
+  case TimeSeriesReader::Predicate::not_equal:     return filter(values, size, predicate.value, selection, std::not_equal_to<double>());
+  }
+}
+
+}  // namespace
+
+std::size_t TimeSeriesReader::scan(
+  const std::vector<std::size_t>& projection,
+  const std::vector<Predicate>& predicates,
+  const Visitor& visit) const
+{
+  std::size_t matched {0};
+
+  std::vector<std::uint8_t> selection {};
+
+  std::vector<double> row(projection.size());
+
+  for (const auto& block : blocks_)
+  {
+    // NOTE: Predicate pushdown; most blocks are skipped by the zone maps alone.
+    if (not std::all_of(predicates.begin(), predicates.end(), [&](const auto& each)
+        {
+          return mayContain(block.zones[each.column], each);
+        }))
+    {
+      continue;
+    }
+
+    selection.assign(block.rows, 1);
+
+    for (const auto& each : predicates)
+    {
+      filter(block.columns + each.column * block.rows, block.rows, each, selection.data());
+    }
+
+    for (std::size_t i {0}; i < block.rows; ++i)
+    {
+      if (selection[i])
+      {
+        for (std::size_t column {0}; column < projection.size(); ++column)
+        {
+          row[column] = block.columns[projection[column] * block.rows + i];
+        }
+
+        visit(row.data());
+
+        ++matched;
+      }
+    }
+  }
+
+  return matched;
+}
+
+}  // namespace scenario_logger
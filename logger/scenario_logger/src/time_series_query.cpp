@@ -0,0 +1,378 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <scenario_logger/time_series.h>
+
+/* -----------------------------------------------------------------------------
+ *
+ * TIME SERIES QUERY
+ *
+ * Scans the time series files recorded by scenario runner (.series), in
+ * parallel across files, and prints the matching rows as CSV.
+ *
+ *   time_series_query [OPTION]... FILE...
+ *
+ *   --columns C,C,...   columns to print (default: all)
+ *   --where EXPR        row filter, repeatable (ANDed)
+ *   --entity NAME       shorthand for --where entity==NAME
+ *   --after EXPR        anchor filter, repeatable (ANDed)
+ *   --after-entity NAME shorthand for --after entity==NAME
+ *   --within SECONDS    keep only rows within SECONDS after an anchor row
+ *   --jobs N            number of threads (default: all cores)
+ *
+ * EXPR is <column><op><value>, where <op> is one of < <= > >= == !=. Values of
+ * the entity column may be given by name.
+ *
+ * Example: ego decelerating harder than 4 m/s^2 within 2 s of npc1 changing
+ * lanes.
+ *
+ *   time_series_query --entity ego --where 'acceleration<-4' \
+ *     --after-entity npc1 --after 'lane_change==1' --within 2 logs/run-*.series
+ *
+ * -------------------------------------------------------------------------- */
+
+namespace
+{
+
+using scenario_logger::TimeSeriesReader;
+
+struct Condition
+{
+  std::string column;
+  TimeSeriesReader::Predicate::Operator op;
+  std::string value;
+};
+
+Condition parseCondition(const std::string& expression)
+{
+  static const std::vector<std::pair<std::string, TimeSeriesReader::Predicate::Operator>> operators {
+    { "<=", TimeSeriesReader::Predicate::less_equal },
+    { ">=", TimeSeriesReader::Predicate::greater_equal },
+    { "==", TimeSeriesReader::Predicate::equal },
+    { "!=", TimeSeriesReader::Predicate::not_equal },
+    { "<",  TimeSeriesReader::Predicate::less },
+    { ">",  TimeSeriesReader::Predicate::greater },
+  };
+
+  for (const auto& each : operators)
+  {
+    const auto position { expression.find(each.first) };
+
+    if (position != std::string::npos and 0 < position)
+    {
+      return { expression.substr(0, position), each.second, expression.substr(position + each.first.size()) };
+    }
+  }
+
+  throw std::invalid_argument { "Malformed expression \"" + expression + "\"." };
+}
+
+/* NOTE: Returns false if the condition can never hold in this file, e.g. an
+ * entity that does not appear in it. */
+bool resolve(
+  const TimeSeriesReader& reader,
+  const std::vector<Condition>& conditions,
+  std::vector<TimeSeriesReader::Predicate>& predicates)
+{
+  for (const auto& each : conditions)
+  {
+    TimeSeriesReader::Predicate predicate { each.op, 0, 0.0 };
+
+    if (not reader.column(each.column, predicate.column))
+    {
+      throw std::invalid_argument { "No such column \"" + each.column + "\"." };
+    }
+
+    char* end {nullptr};
+    predicate.value = std::strtod(each.value.c_str(), &end);
+
+    if (each.value.empty() or *end != '\0')
+    {
+      if (each.column != "entity")
+      {
+        throw std::invalid_argument { "Malformed value \"" + each.value + "\"." };
+      }
+      else if (not reader.name(each.value, predicate.value))
+      {
+        if (each.op == TimeSeriesReader::Predicate::not_equal)
+        {
+          continue;
+        }
+        else
+        {
+          return false;
+        }
+      }
+    }
+
+    predicates.push_back(predicate);
+  }
+
+  return true;
+}
+
+struct Query
+{
+  std::vector<std::string> columns;
+  std::vector<Condition> where, after;
+  double within = -1;  // NOTE: Negative unless --within is given.
+};
+
+std::size_t run(const Query& query, const std::string& path, std::ostream& os)
+{
+  const TimeSeriesReader reader { path };
+
+  std::vector<TimeSeriesReader::Predicate> where {};
+
+  if (not resolve(reader, query.where, where))
+  {
+    return 0;
+  }
+
+  std::size_t time {};
+  std::size_t entity {};
+
+  if (not reader.column("time", time) or not reader.column("entity", entity))
+  {
+    throw std::invalid_argument { "Not a scenario time series file." };
+  }
+
+  std::vector<double> anchors {};
+
+  if (0 <= query.within)
+  {
+    std::vector<TimeSeriesReader::Predicate> after {};
+
+    if (not resolve(reader, query.after, after))
+    {
+      return 0;
+    }
+
+    reader.scan({ time }, after, [&](const double* values)
+    {
+      anchors.push_back(values[0]);
+    });
+
+    if (anchors.empty())
+    {
+      return 0;
+    }
+
+    std::sort(anchors.begin(), anchors.end());
+
+    // NOTE: Let the zone maps skip blocks that end before the first anchor.
+    where.push_back({ TimeSeriesReader::Predicate::greater_equal, time, anchors.front() });
+    where.push_back({ TimeSeriesReader::Predicate::less_equal, time, anchors.back() + query.within });
+  }
+
+  std::vector<std::size_t> projection { time };  // NOTE: Always first, for the window test.
+
+  const auto& columns { query.columns.empty() ? reader.columns() : query.columns };
+
+  for (const auto& each : columns)
+  {
+    std::size_t index {};
+
+    if (not reader.column(each, index))
+    {
+      throw std::invalid_argument { "No such column \"" + each + "\"." };
+    }
+
+    projection.push_back(index);
+  }
+
+  std::size_t matched {0};
+
+  reader.scan(projection, where, [&](const double* values)
+  {
+    if (0 <= query.within)
+    {
+      const auto anchor { std::upper_bound(anchors.begin(), anchors.end(), values[0]) };
+
+      if (anchor == anchors.begin() or query.within < values[0] - *std::prev(anchor))
+      {
+        return;
+      }
+    }
+
+    os << path;
+
+    for (std::size_t column {1}; column < projection.size(); ++column)
+    {
+      os << ",";
+
+      if (projection[column] == entity and values[column] < reader.names().size())
+      {
+        os << reader.names()[static_cast<std::size_t>(values[column])];
+      }
+      else
+      {
+        os << values[column];
+      }
+    }
+
+    os << "\n";
+
+    ++matched;
+  });
+
+  return matched;
+}
+
+std::vector<std::string> split(const std::string& s, char delimiter)
+{
+  std::vector<std::string> result {};
+
+  std::istringstream iss { s };
+
+  for (std::string each {}; std::getline(iss, each, delimiter); )
+  {
+    if (not each.empty())
+    {
+      result.push_back(each);
+    }
+  }
+
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) try
+{
+  Query query {};
+
+  std::vector<std::string> paths {};
+
+  std::size_t jobs { std::max(1u, std::thread::hardware_concurrency()) };
+
+  for (int i {1}; i < argc; ++i)
+  {
+    const std::string option { argv[i] };
+
+    const auto argument = [&]()
+    {
+      if (++i < argc)
+      {
+        return std::string { argv[i] };
+      }
+      else
+      {
+        throw std::invalid_argument { "Option " + option + " requires an argument." };
+      }
+    };
+
+    if (option == "--columns")
+    {
+      query.columns = split(argument(), ',');
+    }
+    else if (option == "--where")
+    {
+      query.where.push_back(parseCondition(argument()));
+    }
+    else if (option == "--entity")
+    {
+      query.where.push_back({ "entity", TimeSeriesReader::Predicate::equal, argument() });
+    }
+    else if (option == "--after")
+    {
+      query.after.push_back(parseCondition(argument()));
+    }
+    else if (option == "--after-entity")
+    {
+      query.after.push_back({ "entity", TimeSeriesReader::Predicate::equal, argument() });
+    }
+    else if (option == "--within")
+    {
+      query.within = std::stod(argument());
+    }
+    else if (option == "--jobs")
+    {
+      jobs = std::max(1, std::stoi(argument()));
+    }
+    else if (option.compare(0, 2, "--") == 0)
+    {
+      throw std::invalid_argument { "Unknown option " + option + "." };
+    }
+    else
+    {
+      paths.push_back(option);
+    }
+  }
+
+  if (paths.empty())
+  {
+    std::cerr << "Usage: " << argv[0] << " [OPTION]... FILE..." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (not query.after.empty() and query.within < 0)
+  {
+    throw std::invalid_argument { "Option --after requires --within." };
+  }
+
+  std::atomic<std::size_t> next {0}, matched {0}, failed {0};
+
+  std::mutex mutex {};
+
+  const auto work = [&]()
+  {
+    for (auto index { next++ }; index < paths.size(); index = next++)
+    {
+      std::ostringstream oss {};
+
+      try
+      {
+        matched += run(query, paths[index], oss);
+      }
+      catch (const std::exception& e)
+      {
+        ++failed;
+        oss.str("");
+        std::lock_guard<std::mutex> lock { mutex };
+        std::cerr << paths[index] << ": " << e.what() << std::endl;
+        continue;
+      }
+
+      std::lock_guard<std::mutex> lock { mutex };
+      std::cout << oss.str();
+    }
+  };
+
+  std::vector<std::thread> threads {};
+
+  for (std::size_t thread {1}; thread < std::min(jobs, paths.size()); ++thread)
+  {
+    threads.emplace_back(work);
+  }
+
+  work();
+
+  for (auto& each : threads)
+  {
+    each.join();
+  }
+
+  std::cerr << matched << " rows matched in " << paths.size() - failed << " files";
+
+  if (failed)
+  {
+    std::cerr << " (" << failed << " files failed)";
+  }
+
+  std::cerr << "." << std::endl;
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+catch (const std::exception& e)
+{
+  std::cerr << e.what() << std::endl;
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,34 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <scenario_logger/clock.h>
+
+using scenario_logger::Clock;
+
+TEST(Clock, LatchesOnlyTheTickingThread)
+{
+  Clock clock {};
+
+  ros::Time source { 1, 0 };
+  clock.setSource([&]() { return source; });
+
+  {
+    const Clock::Tick latch { clock };
+
+    source = ros::Time { 2, 0 };
+    EXPECT_EQ(clock.now(), ros::Time(1, 0));
+
+    ros::Time elsewhere {};
+    std::thread { [&]() { elsewhere = clock.now(); } }.join();
+    EXPECT_EQ(elsewhere, ros::Time(2, 0));
+  }
+
+  EXPECT_EQ(clock.now(), ros::Time(2, 0));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,58 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <scenario_logger/flood_control.h>
+
+using scenario_logger::FloodControl;
+
+TEST(FloodControl, LimitsRepeatsOfATemplate)
+{
+  FloodControl flood_control { 60.0, 20, 3 };
+
+  for (int i {0}; i < 3; ++i)
+  {
+    EXPECT_TRUE(flood_control.admit("a.cpp:1", "speed " + std::to_string(i)));
+  }
+
+  EXPECT_FALSE(flood_control.admit("a.cpp:1", "speed 3"));
+
+  EXPECT_EQ(*flood_control.admit("a.cpp:1", "other"), "other [1 similar messages suppressed]");
+  EXPECT_EQ(flood_control.suppressed(), 1u);
+}
+
+TEST(FloodControl, LimitsBurstOfASite)
+{
+  FloodControl flood_control { 60.0, 2, 3 };
+
+  EXPECT_TRUE(flood_control.admit("a.cpp:1", "x"));
+  EXPECT_TRUE(flood_control.admit("a.cpp:1", "y"));
+  EXPECT_FALSE(flood_control.admit("a.cpp:1", "z"));
+
+  const auto pending { flood_control.flush() };
+  ASSERT_EQ(pending.size(), 1u);
+  EXPECT_EQ(pending.front().second, 1u);
+  EXPECT_TRUE(flood_control.flush().empty());
+}
+
+// NOTE: The parsers warn from one line, as a site per clause.
+TEST(FloodControl, KeepsSitesApart)
+{
+  FloodControl flood_control { 60.0, 2, 3 };
+
+  for (const auto& clause : {"Delay", "Period", "Speed", "Acceleration"})
+  {
+    const auto from { std::string("parse.h:90 (") + clause + ")" };
+
+    EXPECT_TRUE(flood_control.admit(from, std::string("missing optional clause ") + clause));
+    EXPECT_TRUE(flood_control.admit(from, std::string("missing optional clause ") + clause));
+  }
+
+  EXPECT_EQ(flood_control.suppressed(), 0u);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <scenario_logger/time_series.h>
+
+using scenario_logger::TimeSeriesReader;
+using scenario_logger::TimeSeriesWriter;
+
+namespace
+{
+
+constexpr std::size_t block_rows { 4 };
+
+const std::string path { "/tmp/test_time_series.series" };
+
+std::vector<char> read(const std::string& path)
+{
+  std::ifstream ifs { path, std::ios::binary };
+  return { std::istreambuf_iterator<char> {ifs}, std::istreambuf_iterator<char> {} };
+}
+
+void write(const std::string& path, const std::vector<char>& bytes, std::size_t size)
+{
+  std::ofstream ofs { path, std::ios::binary | std::ios::trunc };
+  ofs.write(bytes.data(), size);
+}
+
+// 10 rows of (time, entity), each row naming a new entity
+std::vector<char> record()
+{
+  {
+    TimeSeriesWriter writer { path, {"time", "entity"}, block_rows };
+
+    for (int row {0}; row < 10; ++row)
+    {
+      const double values[] { static_cast<double>(row), writer.intern("entity" + std::to_string(row)) };
+      writer.append(values);
+    }
+
+    writer.close();
+  }
+
+  return read(path);
+}
+
+std::vector<double> scan(const TimeSeriesReader& reader)
+{
+  std::vector<double> times {};
+  reader.scan({0}, {}, [&](const double* columns) { times.push_back(columns[0]); });
+  return times;
+}
+
+}  // namespace
+
+TEST(TimeSeries, ReadsClosedFile)
+{
+  record();
+
+  TimeSeriesReader reader { path };
+
+  EXPECT_EQ(reader.columns(), (std::vector<std::string> {"time", "entity"}));
+  EXPECT_EQ(scan(reader).size(), 10u);
+  ASSERT_EQ(reader.names().size(), 10u);
+  EXPECT_EQ(reader.names().back(), "entity9");
+}
+
+// NOTE: A killed run leaves no trailer, and maybe part of a block.
+TEST(TimeSeries, ReadsCompleteBlocksOfTruncatedFile)
+{
+  const auto bytes { record() };
+
+  std::size_t previous {0};
+  std::vector<std::size_t> boundaries {};  // sizes at which a block becomes readable
+
+  for (std::size_t size {0}; size < bytes.size(); ++size)
+  {
+    write(path, bytes, size);
+
+    std::vector<double> times {};
+
+    try
+    {
+      TimeSeriesReader reader { path };
+
+      times = scan(reader);
+
+      // every entity of the rows read is named
+      reader.scan({1}, {}, [&](const double* columns)
+      {
+        EXPECT_LT(columns[0], reader.names().size()) << "truncated to " << size;
+      });
+    }
+    catch (const std::runtime_error&)
+    {
+      EXPECT_TRUE(boundaries.empty()) << "unreadable when truncated to " << size;
+      continue;
+    }
+
+    ASSERT_GE(times.size(), previous) << "truncated to " << size;
+
+    for (std::size_t row {0}; row < times.size(); ++row)
+    {
+      EXPECT_EQ(times[row], row);
+    }
+
+    if (previous < times.size() or boundaries.empty())
+    {
+      boundaries.push_back(size);
+    }
+
+    previous = times.size();
+  }
+
+  // NOTE: The header alone, then after 1, 2 and 3 blocks (the last one partial).
+  ASSERT_EQ(boundaries.size(), 4u);
+
+  for (std::size_t blocks {1}; blocks < boundaries.size(); ++blocks)
+  {
+    write(path, bytes, boundaries[blocks]);
+
+    TimeSeriesReader reader { path };
+    EXPECT_EQ(scan(reader).size(), std::min(blocks * block_rows, std::size_t {10}));
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(TimeSeries, RejectsOtherFiles)
+{
+  write(path, std::vector<char>(64, 'x'), 64);
+  EXPECT_THROW(TimeSeriesReader {path}, std::runtime_error);
+
+  std::remove(path.c_str());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
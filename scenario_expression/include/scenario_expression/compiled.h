@@ -0,0 +1,84 @@
+#ifndef INCLUDED_SCENARIO_EXPRESSION_COMPILED_H
+#define INCLUDED_SCENARIO_EXPRESSION_COMPILED_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <scenario_conditions/condition_base.h>
+#include <scenario_intersection/intersection_manager.h>
+
+namespace scenario_expression
+{
+namespace compiled
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * COMPILED END CONDITION
+ *
+ * What the sources generated by Compiler (see compiler.h) and the runner that
+ * loads the shared objects built from them agree on. A shared object exports
+ * one EndCondition named `scenario_end_condition`, whose functions evaluate
+ * the success and failure conditions over the predicates of the interpreted
+ * expressions, given in the order the compiler visited them.
+ *
+ * -------------------------------------------------------------------------- */
+
+// NOTE: Bump whenever the layout of anything in this file changes.
+constexpr std::uint32_t abi_version { 2 };
+
+// NOTE: Bump whenever ConditionBase changes, as the generated code calls its inline members.
+constexpr std::uint64_t plugin_abi_version { 1 };
+
+constexpr auto symbol { "scenario_end_condition" };
+
+struct Predicate
+{
+  scenario_conditions::ConditionBase* plugin;
+
+  bool batched;
+
+  bool replayed; // NOTE: Its result of this tick is read instead, as the interpreter updated it (verify mode).
+};
+
+using Intersections = std::shared_ptr<scenario_intersection::IntersectionManager>;
+
+struct Result
+{
+  bool value;
+
+  double robustness;
+};
+
+using Function = Result (*)(const Predicate*, const Intersections&);
+
+struct EndCondition
+{
+  std::uint32_t abi;
+
+  std::uint64_t plugin_abi;
+
+  std::uint64_t signature; // NOTE: Hash of the generated source.
+
+  std::size_t size; // NOTE: Number of predicates.
+
+  Function success, failure;
+};
+
+template <typename Condition>
+inline bool update(const Predicate& predicate, const Intersections& intersections)
+{
+  if (predicate.replayed)
+  {
+    return predicate.plugin->getResult();
+  }
+
+  // NOTE: Qualified, so that the call is bound statically instead of through the vtable.
+  return predicate.batched ? predicate.plugin->updateFromBatch()
+                           : static_cast<Condition&>(*predicate.plugin).Condition::update(intersections);
+}
+
+} // namespace compiled
+} // namespace scenario_expression
+
+#endif // INCLUDED_SCENARIO_EXPRESSION_COMPILED_H
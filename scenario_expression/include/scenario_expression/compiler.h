@@ -0,0 +1,80 @@
+#ifndef INCLUDED_SCENARIO_EXPRESSION_COMPILER_H
+#define INCLUDED_SCENARIO_EXPRESSION_COMPILER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <scenario_expression/compiled.h>
+#include <scenario_expression/expression.h>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace scenario_expression
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * COMPILER
+ *
+ * Translates the success and failure conditions of a loaded scenario into a
+ * C++ source, to be built into a shared object (see compiled.h):
+ *
+ *   <Literal>    a constexpr constant
+ *   <And>, <Or>  straight-line code over the values of the operands, which are
+ *                all evaluated in order as the interpreter does
+ *   <Predicate>  a statically bound call of the update of its plugin's class
+ *
+ * The plugins themselves are not compiled. They are the ones the interpreter
+ * loaded and configured, handed to the shared object by predicates(), so their
+ * parameters stay those of the scenario.
+ *
+ * -------------------------------------------------------------------------- */
+class Compiler
+{
+public:
+  explicit Compiler(std::uint64_t plugin_abi);
+
+  std::string compile(const Expression& success, const Expression& failure);
+
+  // NOTE: Hash of the last source compiled, as recorded in it.
+  std::uint64_t signature() const noexcept
+  {
+    return signature_;
+  }
+
+  // NOTE: In the order the last source compiled expects them.
+  const std::vector<compiled::Predicate>& predicates() const noexcept
+  {
+    return predicates_;
+  }
+
+  /* ---- Called back by the expressions ----------------------------------- */
+
+  std::size_t literal(bool value, double robustness);
+
+  std::size_t predicate(const std::string& class_type, scenario_conditions::ConditionBase*, bool batched);
+
+  std::size_t logical(bool conjunction, const std::vector<std::size_t>& operands);
+
+  static std::string headerOf(const std::string& class_type);
+
+private:
+  void function(const std::string& name, const Expression&);
+
+  const std::uint64_t plugin_abi_;
+
+  std::uint64_t signature_;
+
+  std::vector<compiled::Predicate> predicates_;
+
+  std::set<std::string> headers_;
+
+  std::stringstream body_;
+
+  std::size_t variables_;
+};
+
+} // namespace scenario_expression
+
+#endif // INCLUDED_SCENARIO_EXPRESSION_COMPILER_H
@@ -2,16 +2,24 @@
 #define INCLUDED_SCENARIO_EXPRESSION_EXPRESSION_H
 
 #include <algorithm>
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <functional>
 #include <ios>
 #include <iostream>
+#include <limits>
 #include <pluginlib/class_loader.h>
 #include <ros/ros.h>
+#include <scenario_actions/entity_index.h>
+#include <scenario_actions/timer_wheel.h>
 #include <scenario_api/scenario_api_core.h>
 #include <scenario_conditions/condition_base.h>
+#include <scenario_conditions/condition_groups.h>
 #include <scenario_entities/entity_manager.h>
 #include <scenario_intersection/intersection_manager.h>
+#include <scenario_logger/dispatch_latency.h>
+#include <scenario_logger/perf_counters.h>
+#include <scenario_logger/tick_watchdog.h>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -20,6 +28,8 @@
 namespace scenario_expression
 {
 
+class Optimizer;
+
 class Context
 {
 #define boilerplate(TYPE, NAME)                                                \
@@ -52,6 +62,13 @@ public:                                                                        \
   boilerplate(ScenarioAPI, api);
   boilerplate(scenario_entities::EntityManager, entities);
   boilerplate(scenario_intersection::IntersectionManager, intersections);
+  boilerplate(scenario_logger::PerfCounters, perf_counters);
+  boilerplate(scenario_conditions::ConditionGroups, condition_groups);
+  boilerplate(scenario_actions::TimerWheel, timer_wheel);
+  boilerplate(scenario_actions::EntityIndex, entity_index);
+  boilerplate(scenario_logger::TickWatchdog, tick_watchdog);
+  boilerplate(scenario_logger::DispatchLatency, dispatch_latency);
+  boilerplate(Optimizer, optimizer);
 
 #undef boilerplate
 };
@@ -92,6 +109,12 @@ public:                                                                        \
  * the expression is equal to false or not. Note that the return value of the
  * expression is not necessarily Boolean.
  *
+ * ROBUSTNESS
+ *   After evaluation, each expression also reports a signed margin of its last
+ *   result (signal temporal logic robustness): a predicate reports that of its
+ *   condition, <And> the minimum and <Or> the maximum over its operands. It is
+ *   non-negative if and only if the result was true.
+ *
  * -------------------------------------------------------------------------- */
 
 template <typename T>
@@ -104,6 +127,8 @@ class Or;
 
 class Predicate;
 
+class Compiler;
+
 class Expression
 {
   friend Boolean;
@@ -113,6 +138,8 @@ class Expression
   friend And;
   friend Or;
 
+  friend Optimizer;
+
 public:
   Expression()
     : data { nullptr }
@@ -177,6 +204,23 @@ public:
     return data ? static_cast<bool>(*data) : false;
   }
 
+  virtual double robustness() const noexcept
+  {
+    return data ? data->robustness() : -std::numeric_limits<double>::infinity();
+  }
+
+  // NOTE: Ahead-of-time compilation, see compiler.h. Returns the variable holding the value.
+  virtual std::size_t compile(Compiler&) const;
+
+  // NOTE: Whether the batched predicates within are updated in the next ticks (see condition_groups.h).
+  virtual void activate(scenario_conditions::ConditionGroups& groups, bool active) const
+  {
+    if (data)
+    {
+      data->activate(groups, active);
+    }
+  }
+
 protected:
   Expression(std::integral_constant<decltype(0), 0>)
     : data { nullptr }
@@ -201,12 +245,20 @@ private:
 
 Expression read(Context&, const YAML::Node&);
 
+// NOTE: Returns the expression as is unless the context defines an optimizer (see optimizer.h).
+Expression optimize(Context&, const Expression&);
+
+// NOTE: Does nothing unless the context defines condition groups.
+void activate(Context&, const Expression&, bool active);
+
 template <typename T>
 class Literal
   : public Expression
 {
   friend Expression;
 
+  friend Optimizer;
+
   T value;
 
 protected:
@@ -229,33 +281,58 @@ protected:
 
   Expression evaluate(Context&) override
   {
-    return *this;
+    // NOTE: Not *this, which would be sliced into an empty expression (false).
+    return Expression::make<Literal>(value);
   }
 
   operator bool() const noexcept override
   {
     return value;
   }
+
+  double robustness() const noexcept override
+  {
+    return (value ? 1 : -1) * std::numeric_limits<double>::infinity();
+  }
+
+  std::size_t compile(Compiler&) const override;
 };
 
-#define DEFINE_N_ARY_LOGICAL_EXPRESSION(NAME, OPERATOR, BASE_CASE)             \
+template <>
+std::size_t Literal<bool>::compile(Compiler&) const;
+
+#define DEFINE_N_ARY_LOGICAL_EXPRESSION(NAME, OPERATOR, BASE_CASE, SELECT)     \
 class NAME                                                                     \
   : public Expression                                                          \
 {                                                                              \
   friend Expression;                                                           \
                                                                                \
+  friend Optimizer;                                                            \
+                                                                               \
   OPERATOR<bool> combine;                                                      \
                                                                                \
   std::vector<Expression> operands;                                            \
                                                                                \
+  double margin;                                                               \
+                                                                               \
+  std::size_t required; /* NOTE: Leading operands never short-circuited. */    \
+                                                                               \
+  bool short_circuit; /* NOTE: Set by the optimizer. */                        \
+                                                                               \
 protected:                                                                     \
   NAME(const NAME& rhs)                                                        \
     : Expression { std::integral_constant<decltype(0), 0>() }                  \
     , operands { rhs.operands }                                                \
+    , margin { rhs.margin }                                                    \
+    , required { rhs.required }                                                \
+    , short_circuit { rhs.short_circuit }                                      \
   {}                                                                           \
                                                                                \
   NAME(Context& context, const YAML::Node& node)                               \
     : Expression { std::integral_constant<decltype(0), 0>() }                  \
+    , margin { (BASE_CASE ? 1 : -1) * std::numeric_limits<double>::infinity() }\
+    , required { 0 }                                                           \
+    , short_circuit { false }                                                  \
   {                                                                            \
     if (node.IsSequence())                                                     \
     {                                                                          \
@@ -270,14 +347,38 @@ protected:                                                                     \
                                                                                \
   Expression evaluate(Context& context) override                               \
   {                                                                            \
-    return                                                                     \
-      Expression::make<Boolean>(                                               \
-      std::accumulate(                                                         \
-        operands.begin(), operands.end(), BASE_CASE,                           \
-        [&](const auto& lhs, auto&& rhs)                                       \
-        {                                                                      \
-          return combine(lhs, rhs.evaluate(context));                          \
-        }));                                                                   \
+    margin = (BASE_CASE ? 1 : -1) * std::numeric_limits<double>::infinity();   \
+                                                                               \
+    bool result { BASE_CASE };                                                 \
+                                                                               \
+    for (std::size_t i { 0 }; i < operands.size(); ++i)                        \
+    {                                                                          \
+      /* NOTE: The margin then covers the operands evaluated only. */          \
+      if (short_circuit and required <= i and result != BASE_CASE)             \
+      {                                                                        \
+        break;                                                                 \
+      }                                                                        \
+                                                                               \
+      result = combine(result, operands[i].evaluate(context));                 \
+      margin = SELECT<double>(margin, operands[i].robustness());               \
+    }                                                                          \
+                                                                               \
+    return Expression::make<Boolean>(result);                                  \
+  }                                                                            \
+                                                                               \
+  double robustness() const noexcept override                                  \
+  {                                                                            \
+    return margin;                                                             \
+  }                                                                            \
+                                                                               \
+  std::size_t compile(Compiler&) const override;                               \
+                                                                               \
+  void activate(scenario_conditions::ConditionGroups& groups, bool active) const override \
+  {                                                                            \
+    for (const auto& each : operands)                                          \
+    {                                                                          \
+      each.activate(groups, active);                                           \
+    }                                                                          \
   }                                                                            \
                                                                                \
   std::ostream& write(std::ostream& os) const override                         \
@@ -293,8 +394,8 @@ protected:                                                                     \
   }                                                                            \
 }
 
-DEFINE_N_ARY_LOGICAL_EXPRESSION(And, std::logical_and, true);
-DEFINE_N_ARY_LOGICAL_EXPRESSION(Or, std::logical_or, false);
+DEFINE_N_ARY_LOGICAL_EXPRESSION(And, std::logical_and, true, std::min);
+DEFINE_N_ARY_LOGICAL_EXPRESSION(Or, std::logical_or, false, std::max);
 
 template <typename PluginBase>
 class Procedure
@@ -305,6 +406,10 @@ class Procedure
 protected:
   boost::shared_ptr<PluginBase> plugin;
 
+  std::string label; // NOTE: Name of perf counter measurements.
+
+  std::string class_type; // NOTE: C++ type of the plugin, for the compiler.
+
   Procedure()
     : Expression { std::integral_constant<decltype(0), 0>() }
   {}
@@ -312,6 +417,8 @@ protected:
   Procedure(const Procedure& proc)
     : Expression { std::integral_constant<decltype(0), 0>() }
     , plugin { proc.plugin }
+    , label { proc.label }
+    , class_type { proc.class_type }
   {}
 
   virtual ~Procedure() = default;
@@ -329,6 +436,7 @@ protected:
     {
       if (loader().getName(declaration) == name)
       {
+        class_type = loader().getClassType(declaration);
         return loader().createInstance(declaration);
       }
     }
@@ -338,6 +446,13 @@ protected:
 
   Expression evaluate(Context& context) override
   {
+    // NOTE: Measured only if the runner defined perf counters (opt-in).
+    const auto measurement {
+      context.perf_counters_pointer()
+        ? context.perf_counters_pointer()->measure(label)
+        : scenario_logger::PerfCounters::Scope()
+    };
+
     return Expression::make<Boolean>(plugin->update(context.intersections_pointer()));
   }
 };
@@ -347,16 +462,46 @@ class Predicate
 {
   friend Expression;
 
+  friend Optimizer;
+
 protected:
   using Procedure::Procedure;
 
+  bool batched = false; // NOTE: Updated by the context's condition groups.
+
+  bool low_priority = false; // NOTE: Deferred while the tick watchdog sheds load.
+
+  std::size_t deferred = 0; // NOTE: Ticks skipped in a row.
+
+  std::string definition; // NOTE: Predicates of the same definition are the same, for the optimizer.
+
   Predicate(Context& context, const YAML::Node& node)
   try
     : Procedure {}
   {
+    // NOTE: Not call_with_optional, which warns about every predicate without it.
+    if (const auto priority { node["Priority"] })
+    {
+      if (boost::iequals(priority.as<std::string>(), "Low"))
+      {
+        low_priority = true;
+      }
+      else if (not boost::iequals(priority.as<std::string>(), "Normal"))
+      {
+        SCENARIO_ERROR_THROW(CATEGORY(), "Priority must be Low or Normal, but " << priority << " given.");
+      }
+    }
+
     if (plugin = load(read_essential<std::string>(node, "Type") + "Condition"))
     {
       plugin->configure(node, context.api_pointer());
+      label = "condition/" + plugin->getType();
+      definition = YAML::Dump(node);
+
+      if (context.condition_groups_pointer())
+      {
+        batched = context.condition_groups_pointer()->add(plugin);
+      }
     }
     else
     {
@@ -370,6 +515,38 @@ protected:
 
   virtual ~Predicate() = default;
 
+  Expression evaluate(Context& context) override
+  {
+    if (batched)
+    {
+      // NOTE: Never deferred, as the batch pass of its group has been paid for anyway.
+      return Expression::make<Boolean>(plugin->updateFromBatch());
+    }
+    else if (low_priority and context.tick_watchdog_pointer() and context.tick_watchdog().defer(deferred))
+    {
+      return Expression::make<Boolean>(plugin->getResult());
+    }
+    else
+    {
+      return Procedure::evaluate(context);
+    }
+  }
+
+  double robustness() const noexcept override
+  {
+    return plugin ? plugin->getRobustness() : -std::numeric_limits<double>::infinity();
+  }
+
+  void activate(scenario_conditions::ConditionGroups& groups, bool active) const override
+  {
+    if (batched)
+    {
+      groups.activate(plugin, active);
+    }
+  }
+
+  std::size_t compile(Compiler&) const override;
+
   pluginlib::ClassLoader<scenario_conditions::ConditionBase>& loader() const
   {
     static pluginlib::ClassLoader<scenario_conditions::ConditionBase> loader {
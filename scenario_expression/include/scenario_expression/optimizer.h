@@ -0,0 +1,75 @@
+#ifndef INCLUDED_SCENARIO_EXPRESSION_OPTIMIZER_H
+#define INCLUDED_SCENARIO_EXPRESSION_OPTIMIZER_H
+
+#include <cstddef>
+#include <memory>
+#include <scenario_expression/expression.h>
+#include <set>
+#include <string>
+
+namespace scenario_expression
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * OPTIMIZER
+ *
+ * Rewrites an expression once after it was read, keeping its value in every
+ * tick (and its robustness, unless short-circuiting):
+ *
+ *   flattening      <And> in <And> and <Or> in <Or> are merged into one
+ *   folding         AlwaysTrue and AlwaysFalse predicates become literals;
+ *                   identities are dropped (true in <And>, false in <Or>),
+ *                   absorbing elements replace the whole (false in <And>,
+ *                   true in <Or>), and empty or single operand <And> and <Or>
+ *                   are replaced by their value
+ *   deduplication   operands of the same definition are evaluated once
+ *
+ * Predicates dropped on the way are removed from the condition groups given,
+ * so that their batch pass is not run any longer.
+ *
+ * With short_circuit (opt-in) the operands are also reordered: those whose
+ * result depends on the ticks they were evaluated in (predicates with Keep)
+ * come first in their written order, the others follow from cheapest to
+ * costliest: batched predicates, then the others by the estimated cost of
+ * their plugin type (see optimizer.cpp). <And> and <Or> then stop
+ * at the first operand after those that decides their value. The operands
+ * skipped keep their last result and robustness, and log no changes of their
+ * value meanwhile; the robustness of the whole covers the operands evaluated
+ * only, so this is not for end conditions whose robustness is monitored or
+ * that are compiled (see compiler.h).
+ *
+ * -------------------------------------------------------------------------- */
+class Optimizer
+{
+public:
+  explicit Optimizer(bool short_circuit = false);
+
+  Expression optimize(
+    const Expression&,
+    const std::shared_ptr<scenario_conditions::ConditionGroups>& = nullptr);
+
+  static std::size_t size(const Expression&);  // NOTE: Number of nodes.
+
+private:
+  Expression rewrite(const Expression&);
+
+  template <typename Logical>
+  Expression rewrite(const Logical&, bool base_case);
+
+  static std::string key(const Expression&);
+
+  static std::size_t cost(const Expression&);
+
+  static bool stateful(const Expression&);
+
+  static void collect(const Expression&, std::set<const Predicate*>&);
+
+  const bool short_circuit_;
+
+  std::size_t folded_, deduplicated_;
+};
+
+} // namespace scenario_expression
+
+#endif // INCLUDED_SCENARIO_EXPRESSION_OPTIMIZER_H
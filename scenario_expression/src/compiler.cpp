@@ -0,0 +1,224 @@
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <scenario_expression/compiler.h>
+
+namespace scenario_expression
+{
+
+namespace
+{
+
+std::uint64_t hash(const std::string& bytes) noexcept
+{
+  std::uint64_t result { 0xcbf29ce484222325ull }; // FNV-1a
+
+  for (const auto& each : bytes)
+  {
+    result ^= static_cast<unsigned char>(each);
+    result *= 0x100000001b3ull;
+  }
+
+  return result;
+}
+
+std::string constant(double value)
+{
+  if (std::isinf(value))
+  {
+    return value < 0 ? "-inf" : "inf";
+  }
+  else
+  {
+    std::stringstream ss {};
+    ss << std::setprecision(17) << value;
+    return ss.str();
+  }
+}
+
+std::vector<std::size_t> compile(Compiler& compiler, const std::vector<Expression>& operands)
+{
+  std::vector<std::size_t> result {};
+
+  for (const auto& each : operands)
+  {
+    result.push_back(each.compile(compiler));
+  }
+
+  return result;
+}
+
+} // namespace
+
+std::size_t Expression::compile(Compiler& compiler) const
+{
+  return data ? data->compile(compiler) : compiler.literal(false, -std::numeric_limits<double>::infinity());
+}
+
+template <>
+std::size_t Literal<bool>::compile(Compiler& compiler) const
+{
+  return compiler.literal(value, robustness());
+}
+
+std::size_t And::compile(Compiler& compiler) const
+{
+  return compiler.logical(true, scenario_expression::compile(compiler, operands));
+}
+
+std::size_t Or::compile(Compiler& compiler) const
+{
+  return compiler.logical(false, scenario_expression::compile(compiler, operands));
+}
+
+std::size_t Predicate::compile(Compiler& compiler) const
+{
+  if (low_priority)
+  {
+    SCENARIO_WARN_STREAM(CATEGORY(),
+      "Compiled predicate " << plugin->getName() << " is never deferred, regardless of its Priority.");
+  }
+
+  return compiler.predicate(class_type, plugin.get(), batched);
+}
+
+Compiler::Compiler(std::uint64_t plugin_abi)
+  : plugin_abi_ { plugin_abi }
+  , signature_ { 0 }
+  , variables_ { 0 }
+{}
+
+std::string Compiler::headerOf(const std::string& class_type)
+{
+  // NOTE: condition_plugins::InLaneletCondition is declared in condition_plugins/in_lanelet_condition.h
+  std::string result {};
+
+  for (auto iter { class_type.begin() }; iter != class_type.end(); ++iter)
+  {
+    if (*iter == ':')
+    {
+      result.push_back('/');
+      ++iter;
+    }
+    else if (std::isupper(static_cast<unsigned char>(*iter)))
+    {
+      if (not result.empty() and result.back() != '/')
+      {
+        result.push_back('_');
+      }
+
+      result.push_back(std::tolower(static_cast<unsigned char>(*iter)));
+    }
+    else
+    {
+      result.push_back(*iter);
+    }
+  }
+
+  return result + ".h";
+}
+
+std::size_t Compiler::literal(bool value, double robustness)
+{
+  body_ << "  constexpr bool b" << variables_ << " { " << std::boolalpha << value << " };\n"
+        << "  constexpr double r" << variables_ << " { " << constant(robustness) << " };\n";
+
+  return variables_++;
+}
+
+std::size_t Compiler::predicate(
+  const std::string& class_type, scenario_conditions::ConditionBase* plugin, bool batched)
+{
+  if (class_type.empty() or not plugin)
+  {
+    SCENARIO_ERROR_THROW(CATEGORY(), "Cannot compile a predicate whose plugin failed to load.");
+  }
+
+  headers_.insert(headerOf(class_type));
+
+  const auto index { predicates_.size() };
+
+  predicates_.push_back({ plugin, batched, false });
+
+  body_ << "  const bool b" << variables_ << " { update<" << class_type << ">(p[" << index << "], intersections) };\n"
+        << "  const double r" << variables_ << " { p[" << index << "].plugin->getRobustness() };\n";
+
+  return variables_++;
+}
+
+std::size_t Compiler::logical(bool conjunction, const std::vector<std::size_t>& operands)
+{
+  body_ << "  const bool b" << variables_ << " { " << std::boolalpha << conjunction;
+
+  for (const auto& each : operands)
+  {
+    body_ << (conjunction ? " and b" : " or b") << each;
+  }
+
+  // NOTE: The same fold as the interpreter's, from the margin of the base case.
+  body_ << " };\n"
+        << "  const double r" << variables_ << " { std::" << (conjunction ? "min" : "max") << "<double>({ "
+        << (conjunction ? "inf" : "-inf");
+
+  for (const auto& each : operands)
+  {
+    body_ << ", r" << each;
+  }
+
+  body_ << " }) };\n";
+
+  return variables_++;
+}
+
+void Compiler::function(const std::string& name, const Expression& expression)
+{
+  body_ << "// " << expression << "\n"
+        << "Result " << name << "(const Predicate* p, const Intersections& intersections)\n"
+        << "{\n";
+
+  const auto result { expression.compile(*this) };
+
+  body_ << "  return { b" << result << ", r" << result << " };\n"
+        << "}\n\n";
+}
+
+std::string Compiler::compile(const Expression& success, const Expression& failure)
+{
+  predicates_.clear();
+  headers_.clear();
+  body_.str("");
+  variables_ = 0;
+
+  function("success", success);
+  function("failure", failure);
+
+  std::stringstream source {};
+
+  source << "// NOTE: Generated by scenario_expression::Compiler. Do not edit.\n\n"
+         << "#include <algorithm>\n"
+         << "#include <limits>\n\n";
+
+  for (const auto& each : headers_)
+  {
+    source << "#include <" << each << ">\n";
+  }
+
+  source << "#include <scenario_expression/compiled.h>\n\n"
+         << "namespace\n"
+         << "{\n\n"
+         << "using namespace scenario_expression::compiled;\n\n"
+         << "constexpr double inf { std::numeric_limits<double>::infinity() };\n\n"
+         << body_.str()
+         << "} // namespace\n\n";
+
+  signature_ = hash(source.str()) ^ plugin_abi_;
+
+  source << "extern \"C\" const EndCondition " << compiled::symbol << " {\n"
+         << "  abi_version, " << plugin_abi_ << "ull, 0x" << std::hex << signature_ << std::dec << "ull, "
+         << predicates_.size() << ", success, failure\n"
+         << "};\n";
+
+  return source.str();
+}
+
+} // namespace scenario_expression
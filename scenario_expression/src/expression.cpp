@@ -51,6 +51,14 @@ Expression read(Context& context, const YAML::Node& node)
   }
 }
 
+void activate(Context& context, const Expression& expression, bool active)
+{
+  if (context.condition_groups_pointer())
+  {
+    expression.activate(context.condition_groups(), active);
+  }
+}
+
 } // namespace scenario_expression
 
 namespace std
@@ -0,0 +1,314 @@
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <scenario_expression/optimizer.h>
+#include <set>
+#include <sstream>
+
+namespace scenario_expression
+{
+
+namespace
+{
+
+/* NOTE: Relative cost of one evaluation by plugin type, estimated from what
+ * its update calls. Types not listed cost 10. */
+const std::map<std::string, std::size_t> costs {
+  { "AlwaysFalse", 0 },
+  { "AlwaysTrue", 0 },
+  { "ConflictZoneEntered", 2 },  // lookup in the zones updated per tick
+  { "ConflictZoneOccupied", 2 },
+  { "InLanelet", 2 },  // lookup in the lanes assigned per tick
+  { "SameLane", 2 },
+  { "Signal", 2 },  // lookup in the intersection states
+  { "ReachPosition", 5 },  // pose transform and area test
+  { "CollisionByEntity", 20 },  // polygon distance between two footprints
+  { "RelativeDistance", 20 },
+};
+
+} // namespace
+
+Expression optimize(Context& context, const Expression& expression)
+{
+  return context.optimizer_pointer()
+    ? context.optimizer().optimize(expression, context.condition_groups_pointer())
+    : expression;
+}
+
+Optimizer::Optimizer(bool short_circuit)
+  : short_circuit_ { short_circuit }
+  , folded_ { 0 }
+  , deduplicated_ { 0 }
+{}
+
+Expression Optimizer::optimize(
+  const Expression& expression,
+  const std::shared_ptr<scenario_conditions::ConditionGroups>& groups)
+{
+  folded_ = deduplicated_ = 0;
+
+  const auto result { rewrite(expression) };
+
+  if (groups)
+  {
+    std::set<const Predicate*> before {}, after {};
+
+    collect(expression, before);
+    collect(result, after);
+
+    for (const auto& each : before)
+    {
+      if (each->batched and not after.count(each))
+      {
+        groups->remove(each->plugin);
+      }
+    }
+  }
+
+  SCENARIO_INFO_STREAM(CATEGORY(),
+    "Optimized expression of " << size(expression) << " nodes into " << size(result) << " nodes (" <<
+    folded_ << " folded, " << deduplicated_ << " duplicates removed): " << result);
+
+  return result;
+}
+
+std::size_t Optimizer::size(const Expression& expression)
+{
+  if (const auto x { dynamic_cast<const And*>(expression.data) })
+  {
+    return std::accumulate(x->operands.begin(), x->operands.end(), std::size_t { 1 },
+      [](auto lhs, const auto& rhs) { return lhs + size(rhs); });
+  }
+  else if (const auto x { dynamic_cast<const Or*>(expression.data) })
+  {
+    return std::accumulate(x->operands.begin(), x->operands.end(), std::size_t { 1 },
+      [](auto lhs, const auto& rhs) { return lhs + size(rhs); });
+  }
+  else
+  {
+    return 1;
+  }
+}
+
+Expression Optimizer::rewrite(const Expression& expression)
+{
+  if (not expression.data) // NOTE: An empty expression is false.
+  {
+    ++folded_;
+    return Expression::make<Boolean>(false);
+  }
+  else if (const auto x { dynamic_cast<const And*>(expression.data) })
+  {
+    return rewrite(*x, true);
+  }
+  else if (const auto x { dynamic_cast<const Or*>(expression.data) })
+  {
+    return rewrite(*x, false);
+  }
+  else if (const auto x { dynamic_cast<const Predicate*>(expression.data) })
+  {
+    if (x->plugin and x->plugin->getType() == "AlwaysTrue")
+    {
+      ++folded_;
+      return Expression::make<Boolean>(true);
+    }
+    else if (x->plugin and x->plugin->getType() == "AlwaysFalse")
+    {
+      ++folded_;
+      return Expression::make<Boolean>(false);
+    }
+  }
+
+  return expression;
+}
+
+template <typename Logical>
+Expression Optimizer::rewrite(const Logical& logical, bool base_case)
+{
+  std::vector<Expression> operands {};
+
+  std::set<std::string> keys {};
+
+  for (const auto& each : logical.operands)
+  {
+    const auto operand { rewrite(each) };
+
+    const auto nested { dynamic_cast<const Logical*>(operand.data) };
+
+    for (const auto& x : nested ? nested->operands : std::vector<Expression> { operand })
+    {
+      if (const auto literal { dynamic_cast<const Boolean*>(x.data) })
+      {
+        ++folded_;
+
+        // NOTE: The other operands cannot change the value (nor the margin, which is infinite then).
+        if (literal->value != base_case)
+        {
+          return Expression::make<Boolean>(not base_case);
+        }
+      }
+      else if (keys.insert(key(x)).second)
+      {
+        operands.push_back(x);
+      }
+      else
+      {
+        ++deduplicated_;
+      }
+    }
+  }
+
+  if (operands.empty())
+  {
+    return Expression::make<Boolean>(base_case);
+  }
+  else if (operands.size() == 1)
+  {
+    return operands.front();
+  }
+
+  auto result { Expression::make<Logical>(logical) };
+
+  auto& letter { static_cast<Logical&>(*result.data) };
+
+  // NOTE: Reordered only to short-circuit, as the order is that of the entries in the log otherwise.
+  if (short_circuit_)
+  {
+    const auto boundary { std::stable_partition(operands.begin(), operands.end(), stateful) };
+
+    std::stable_sort(boundary, operands.end(), [](const auto& lhs, const auto& rhs)
+    {
+      return cost(lhs) < cost(rhs);
+    });
+
+    letter.required = boundary - operands.begin();
+    letter.short_circuit = true;
+  }
+
+  letter.operands = operands;
+
+  return result;
+}
+
+std::string Optimizer::key(const Expression& expression)
+{
+  std::stringstream ss {};
+
+  if (const auto x { dynamic_cast<const Predicate*>(expression.data) })
+  {
+    if (x->definition.empty()) // NOTE: Then it is only the same as itself.
+    {
+      ss << "(Predicate " << static_cast<const void*>(x) << ")";
+    }
+    else
+    {
+      ss << "(Predicate " << x->definition << ")";
+    }
+  }
+  else if (const auto x { dynamic_cast<const And*>(expression.data) })
+  {
+    ss << "(And";
+
+    for (const auto& each : x->operands)
+    {
+      ss << " " << key(each);
+    }
+
+    ss << ")";
+  }
+  else if (const auto x { dynamic_cast<const Or*>(expression.data) })
+  {
+    ss << "(Or";
+
+    for (const auto& each : x->operands)
+    {
+      ss << " " << key(each);
+    }
+
+    ss << ")";
+  }
+  else
+  {
+    ss << expression;
+  }
+
+  return ss.str();
+}
+
+std::size_t Optimizer::cost(const Expression& expression)
+{
+  if (const auto x { dynamic_cast<const Predicate*>(expression.data) })
+  {
+    if (x->batched) // NOTE: It only reads the result of its group, whatever its type.
+    {
+      return 1;
+    }
+    else if (not x->plugin)
+    {
+      return 10;
+    }
+    else
+    {
+      const auto iter { costs.find(x->plugin->getType()) };
+      return iter != costs.end() ? iter->second : 10;
+    }
+  }
+  else if (const auto x { dynamic_cast<const And*>(expression.data) })
+  {
+    return std::accumulate(x->operands.begin(), x->operands.end(), std::size_t { 1 },
+      [](auto lhs, const auto& rhs) { return lhs + cost(rhs); });
+  }
+  else if (const auto x { dynamic_cast<const Or*>(expression.data) })
+  {
+    return std::accumulate(x->operands.begin(), x->operands.end(), std::size_t { 1 },
+      [](auto lhs, const auto& rhs) { return lhs + cost(rhs); });
+  }
+  else
+  {
+    return 0;
+  }
+}
+
+bool Optimizer::stateful(const Expression& expression)
+{
+  if (const auto x { dynamic_cast<const Predicate*>(expression.data) })
+  {
+    return x->plugin and x->plugin->getKeep();
+  }
+  else if (const auto x { dynamic_cast<const And*>(expression.data) })
+  {
+    return std::any_of(x->operands.begin(), x->operands.end(), stateful);
+  }
+  else if (const auto x { dynamic_cast<const Or*>(expression.data) })
+  {
+    return std::any_of(x->operands.begin(), x->operands.end(), stateful);
+  }
+  else
+  {
+    return false;
+  }
+}
+
+void Optimizer::collect(const Expression& expression, std::set<const Predicate*>& predicates)
+{
+  if (const auto x { dynamic_cast<const Predicate*>(expression.data) })
+  {
+    predicates.insert(x);
+  }
+  else if (const auto x { dynamic_cast<const And*>(expression.data) })
+  {
+    for (const auto& each : x->operands)
+    {
+      collect(each, predicates);
+    }
+  }
+  else if (const auto x { dynamic_cast<const Or*>(expression.data) })
+  {
+    for (const auto& each : x->operands)
+    {
+      collect(each, predicates);
+    }
+  }
+}
+
+} // namespace scenario_expression
@@ -0,0 +1,101 @@
+#ifndef SCENARIO_RUNNER_COMPILED_END_CONDITION_H_INCLUDED
+#define SCENARIO_RUNNER_COMPILED_END_CONDITION_H_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <scenario_expression/compiler.h>
+#include <scenario_utility/misc.h>
+
+namespace scenario_runner
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * COMPILED END CONDITION
+ *
+ * Evaluates the end conditions with a shared object built from the source
+ * scenario_expression::Compiler generated for them (see generate), in place of
+ * the interpreter. The shared object is refused unless it was generated from
+ * the same expressions, with the same plugin ABI; the runner then keeps on
+ * interpreting.
+ *
+ * In verify mode the interpreter stays in charge, and every tick the results
+ * of the shared object are compared to its results. The shared object then
+ * folds the results the interpreter's plugins computed in that tick rather
+ * than updating them a second time, which would advance plugins with state
+ * per update (e.g. monitors accumulating KPIs). Mismatches are counted for the
+ * log metadata (toJson).
+ *
+ * -------------------------------------------------------------------------- */
+class CompiledEndCondition
+{
+public:
+  CompiledEndCondition(
+    const std::string& path,
+    const scenario_expression::Expression& success,
+    const scenario_expression::Expression& failure,
+    bool verify);
+
+  ~CompiledEndCondition();
+
+  CompiledEndCondition(const CompiledEndCondition&) = delete;
+  CompiledEndCondition& operator=(const CompiledEndCondition&) = delete;
+
+  /* NOTE: Writes the source and a CMakeLists.txt building it into `directory`.
+   * Returns the path of the source. */
+  static std::string generate(
+    const std::string& directory,
+    const scenario_expression::Expression& success,
+    const scenario_expression::Expression& failure);
+
+  bool verifies() const noexcept
+  {
+    return verify_;
+  }
+
+  // NOTE: Success is not evaluated in the tick failure holds, as with the interpreter.
+  simulation_is evaluate(const scenario_expression::compiled::Intersections&);
+
+  double successRobustness() const noexcept
+  {
+    return success_.robustness;
+  }
+
+  double failureRobustness() const noexcept
+  {
+    return failure_.robustness;
+  }
+
+  // NOTE: Evaluates both conditions over the results of the interpreter's plugins and compares them.
+  void verify(
+    const scenario_expression::compiled::Intersections&,
+    const scenario_expression::Expression& success,
+    const scenario_expression::Expression& failure);
+
+  boost::property_tree::ptree toJson() const;
+
+private:
+  const std::string path_;
+
+  const bool verify_;
+
+  void* handle_;
+
+  const scenario_expression::compiled::EndCondition* end_condition_;
+
+  std::vector<scenario_expression::compiled::Predicate> predicates_;
+
+  scenario_expression::compiled::Result success_, failure_;
+
+  std::size_t ticks_, mismatches_;
+
+  double first_mismatch_;  // [s] simulation time
+};
+
+}  // namespace scenario_runner
+
+#endif  // SCENARIO_RUNNER_COMPILED_END_CONDITION_H_INCLUDED
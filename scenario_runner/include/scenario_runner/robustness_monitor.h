@@ -0,0 +1,49 @@
+#ifndef SCENARIO_RUNNER_ROBUSTNESS_MONITOR_H_INCLUDED
+#define SCENARIO_RUNNER_ROBUSTNESS_MONITOR_H_INCLUDED
+
+#include <cstddef>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace scenario_runner
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * ROBUSTNESS MONITOR
+ *
+ * Extremes of the robustness of the success and failure conditions over a run,
+ * in O(1) memory. The run's distance from failing is -failure.maximum, and how
+ * closely it passed is success.final; either is a usable objective for
+ * parameter searches. The results are meant for the log metadata (toJson).
+ *
+ * -------------------------------------------------------------------------- */
+class RobustnessMonitor
+{
+public:
+  RobustnessMonitor();
+
+  void update(double success, double failure);
+
+  boost::property_tree::ptree toJson() const;
+
+private:
+  struct Extremes
+  {
+    double minimum, maximum, last;
+
+    Extremes();
+
+    void update(double);
+
+    boost::property_tree::ptree toJson() const;
+  };
+
+  std::size_t ticks_;
+
+  Extremes success_, failure_;
+};
+
+}  // namespace scenario_runner
+
+#endif  // SCENARIO_RUNNER_ROBUSTNESS_MONITOR_H_INCLUDED
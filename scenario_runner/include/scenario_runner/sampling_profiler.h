@@ -0,0 +1,73 @@
+#ifndef SCENARIO_RUNNER_SAMPLING_PROFILER_H_INCLUDED
+#define SCENARIO_RUNNER_SAMPLING_PROFILER_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <csignal>
+#include <ctime>
+#include <memory>
+#include <string>
+
+namespace scenario_runner
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * SAMPLING PROFILER
+ *
+ * A process CPU-time timer (timer_create) raises SIGPROF at the requested
+ * frequency; the handler unwinds the interrupted stack (libunwind, which is
+ * async-signal-safe) into a buffer that start allocates, so nothing is
+ * allocated or locked in signal context. Samples beyond the capacity are
+ * counted and dropped.
+ *
+ * stop writes the stacks, symbolized only then, in folded format (one line
+ * per distinct stack, "root;...;leaf count"), which flamegraph.pl and
+ * speedscope read directly.
+ *
+ * -------------------------------------------------------------------------- */
+class SamplingProfiler
+{
+public:
+  static constexpr std::size_t max_depth { 64 };
+
+  explicit SamplingProfiler(std::size_t capacity = 1 << 16);
+
+  ~SamplingProfiler();
+
+  SamplingProfiler(const SamplingProfiler&) = delete;
+  SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+  bool start(double frequency, const std::string& output_path);
+
+  void stop();  // NOTE: Then writes the stacks sampled.
+
+  bool write() const;
+
+private:
+  static void handle(int, siginfo_t*, void*);
+
+  void record(void* pc) noexcept;
+
+  const std::size_t capacity_;
+
+  std::unique_ptr<void*[]> frames_;
+  std::unique_ptr<unsigned char[]> depths_;
+
+  std::atomic<std::size_t> size_;
+  std::atomic<std::size_t> dropped_;
+
+  std::string output_path_;
+
+  bool running_;
+  timer_t timer_;
+  struct sigaction previous_action_;
+
+  static std::atomic<SamplingProfiler*> active_;
+
+  static std::atomic<int> handling_;  // NOTE: Handlers running, which stop waits for.
+};
+
+}  // namespace scenario_runner
+
+#endif  // SCENARIO_RUNNER_SAMPLING_PROFILER_H_INCLUDED
@@ -2,13 +2,21 @@
 #define SCENARIO_RUNNER_SCENARIO_RUNNER_H_INCLUDED
 
 #include <memory>
+#include <unordered_map>
 
 #include <ros/ros.h>
 
 #include <scenario_expression/expression.h>
 #include <scenario_intersection/intersection_manager.h>
+#include <scenario_logger/dispatch_latency.h>
 #include <scenario_logger/logger.h>
+#include <scenario_logger/perf_counters.h>
+#include <scenario_logger/tick_watchdog.h>
+#include <scenario_logger/time_series.h>
+#include <scenario_runner/compiled_end_condition.h>
+#include <scenario_runner/robustness_monitor.h>
 #include <scenario_runner/scenario_terminater.h>
+#include <scenario_runner/time_monitor.h>
 #include <scenario_sequence/sequence_manager.h>
 #include <scenario_utility/scenario_utility.h>
 
@@ -25,6 +33,12 @@ public:
     return simulator_->getMoveDistance();
   }
 
+  // NOTE: Whether to send progress reports now, or coalesce them while shedding load.
+  bool report()
+  {
+    return not tick_watchdog_ or tick_watchdog_->report();
+  }
+
   simulation_is currently;
 
 private:
@@ -34,6 +48,16 @@ private:
 
   std::string scenario_path_;
 
+  bool use_perf_counters_;
+  bool use_dispatch_latency_;
+  bool record_time_series_;
+  bool optimize_conditions_;
+  bool short_circuit_conditions_;
+
+  std::string compile_end_condition_;   // NOTE: Directory to generate the source into.
+  std::string compiled_end_condition_;  // NOTE: Shared object built from it.
+  bool verify_compiled_end_condition_;
+
   YAML::Node scenario_;
 
   const std::shared_ptr<ScenarioAPI> simulator_;
@@ -46,6 +70,31 @@ private:
   std::shared_ptr<scenario_sequence::SequenceManager> sequence_manager_;
   std::shared_ptr<scenario_intersection::IntersectionManager> intersection_manager_;
 
+  std::shared_ptr<scenario_logger::PerfCounters> perf_counters_;
+
+  std::shared_ptr<scenario_logger::DispatchLatency> dispatch_latency_;
+
+  std::shared_ptr<TimeMonitor> time_monitor_;
+
+  std::shared_ptr<RobustnessMonitor> robustness_monitor_;  // NOTE: Only if ~robustness_monitor.
+
+  std::shared_ptr<scenario_logger::TickWatchdog> tick_watchdog_;  // NOTE: Only if 0 < ~tick_budget.
+
+  std::shared_ptr<CompiledEndCondition> end_condition_;  // NOTE: Only if ~compiled_end_condition.
+
+  struct Recorded
+  {
+    double time, speed;
+    int lane;
+  };
+
+  std::shared_ptr<scenario_logger::TimeSeriesWriter> time_series_;
+  std::unordered_map<std::string, Recorded> recorded_;  // previous row per entity
+
+  scenario_logger::PerfCounters::Scope measure(const std::string& phase);
+
+  void record();
+
   void update(const ros::TimerEvent & event);
 };
 
@@ -0,0 +1,93 @@
+#ifndef SCENARIO_RUNNER_TIME_MONITOR_H_INCLUDED
+#define SCENARIO_RUNNER_TIME_MONITOR_H_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+#include <ros/ros.h>
+
+namespace scenario_runner
+{
+
+/* -----------------------------------------------------------------------------
+ *
+ * TIME MONITOR
+ *
+ * Watches the simulation clock against the wall clock, once per tick:
+ *
+ *   real-time factor  sim-time elapsed / wall-time elapsed, overall and per
+ *                     window (recorded as a time series)
+ *   stall             the simulation clock did not advance for longer than
+ *                     the stall threshold (wall time)
+ *   backward jump     the simulation clock went back (the elapsed times are
+ *                     measured from there on, and added to those before)
+ *   starvation        a tick fired later than the starvation threshold (wall
+ *                     time), i.e. the runner itself was not scheduled
+ *
+ * The timer of the runner runs on the simulation clock, so a slow simulation
+ * spaces ticks out in wall time without delaying any of them. Starvation is
+ * therefore judged by the lag of the tick behind its expected time, which the
+ * last real-time factor converts to wall time, not by the wall time between
+ * ticks (recorded nonetheless).
+ *
+ * The results are meant for the log metadata (toJson).
+ *
+ * -------------------------------------------------------------------------- */
+class TimeMonitor
+{
+public:
+  using wall_clock = std::chrono::steady_clock;
+
+  TimeMonitor(
+    double window = 1.0,                // [s] wall time per real-time factor sample
+    double stall_threshold = 0.5,       // [s] wall time
+    double starvation_threshold = 0.1); // [s] wall time between ticks
+
+  void update(
+    const ros::Time& sim,
+    double lag = 0,  // [s] sim time the tick fired after its expected time
+    wall_clock::time_point wall = wall_clock::now());
+
+  boost::property_tree::ptree toJson() const;
+
+private:
+  struct Sample
+  {
+    double wall_time;  // [s] since the first tick
+    double sim_time;   // [s] since the first tick
+    double real_time_factor;
+  };
+
+  const double window_;
+  const double stall_threshold_;
+  const double starvation_threshold_;
+
+  bool started_;
+
+  ros::Time first_sim_, last_sim_, window_sim_, last_advance_sim_;
+  double sim_time_before_;  // [s] elapsed before the last backward jump
+  wall_clock::time_point first_wall_, last_wall_, window_wall_, last_advance_wall_;
+
+  std::size_t ticks_;
+
+  bool stalled_;
+  std::size_t stalls_;
+  double stalled_time_, longest_stall_;
+
+  std::size_t backward_jumps_;
+  double largest_backward_jump_;
+
+  std::size_t starved_ticks_;
+  double longest_tick_interval_, longest_lag_;
+
+  double real_time_factor_;  // of the last window, or 1 before the first one
+  double min_real_time_factor_, max_real_time_factor_;
+
+  std::vector<Sample> samples_;
+};
+
+}  // namespace scenario_runner
+
+#endif  // SCENARIO_RUNNER_TIME_MONITOR_H_INCLUDED
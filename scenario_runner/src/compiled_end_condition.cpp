@@ -0,0 +1,194 @@
+#include <fstream>
+#include <limits>
+
+#include <dlfcn.h>
+
+#include <boost/filesystem.hpp>
+
+#include <scenario_logger/logger.h>
+#include <scenario_runner/compiled_end_condition.h>
+
+namespace scenario_runner
+{
+
+namespace
+{
+
+constexpr auto cmake_lists {
+  "cmake_minimum_required(VERSION 2.8.3)\n"
+  "project(scenario_end_condition)\n"
+  "\n"
+  "add_compile_options(-std=c++14 -O2)\n"
+  "\n"
+  "find_package(catkin REQUIRED COMPONENTS condition_plugins scenario_expression)\n"
+  "\n"
+  "include_directories(${catkin_INCLUDE_DIRS})\n"
+  "\n"
+  "add_library(scenario_end_condition MODULE end_condition.cpp)\n"
+  "\n"
+  "target_link_libraries(scenario_end_condition ${catkin_LIBRARIES})\n"
+};
+
+bool same(const scenario_expression::compiled::Result& compiled, const scenario_expression::Expression& interpreted)
+{
+  // NOTE: Both fold the same margins in the same order, so they agree exactly.
+  return compiled.value == static_cast<bool>(interpreted) and compiled.robustness == interpreted.robustness();
+}
+
+}  // namespace
+
+CompiledEndCondition::CompiledEndCondition(
+  const std::string& path,
+  const scenario_expression::Expression& success,
+  const scenario_expression::Expression& failure,
+  bool verify)
+  : path_ {path}
+  , verify_ {verify}
+  , handle_ {nullptr}
+  , end_condition_ {nullptr}
+  , success_ {false, -std::numeric_limits<double>::infinity()}
+  , failure_ {false, -std::numeric_limits<double>::infinity()}
+  , ticks_ {0}
+  , mismatches_ {0}
+  , first_mismatch_ {std::numeric_limits<double>::quiet_NaN()}
+{
+  // NOTE: Compiled again, for the signature and the predicates in the order the shared object expects.
+  scenario_expression::Compiler compiler { scenario_expression::compiled::plugin_abi_version };
+  compiler.compile(success, failure);
+
+  if (not (handle_ = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL)))
+  {
+    SCENARIO_ERROR_THROW(CATEGORY(), "Failed to load compiled end condition \"" << path << "\": " << dlerror());
+  }
+
+  end_condition_ = static_cast<const scenario_expression::compiled::EndCondition*>(
+    dlsym(handle_, scenario_expression::compiled::symbol));
+
+  const auto refuse = [&](const auto& reason)
+  {
+    dlclose(handle_);
+    SCENARIO_ERROR_THROW(CATEGORY(), "Refused compiled end condition \"" << path << "\": " << reason);
+  };
+
+  if (not end_condition_)
+  {
+    refuse(std::string("no symbol ") + scenario_expression::compiled::symbol + ".");
+  }
+  else if (end_condition_->abi != scenario_expression::compiled::abi_version or
+           end_condition_->plugin_abi != scenario_expression::compiled::plugin_abi_version)
+  {
+    refuse("built against another ABI.");
+  }
+  else if (end_condition_->signature != compiler.signature() or
+           end_condition_->size != compiler.predicates().size())
+  {
+    refuse("generated from other end conditions.");
+  }
+
+  predicates_ = compiler.predicates();
+
+  for (auto& each : predicates_)
+  {
+    each.replayed = verify_;
+  }
+
+  SCENARIO_INFO_STREAM(CATEGORY(),
+    "Loaded compiled end condition \"" << path << "\" over " << predicates_.size() << " predicates" <<
+    (verify_ ? ", to be verified against the interpreter." : "."));
+}
+
+CompiledEndCondition::~CompiledEndCondition()
+{
+  if (handle_)
+  {
+    dlclose(handle_);
+  }
+}
+
+std::string CompiledEndCondition::generate(
+  const std::string& directory,
+  const scenario_expression::Expression& success,
+  const scenario_expression::Expression& failure)
+{
+  scenario_expression::Compiler compiler { scenario_expression::compiled::plugin_abi_version };
+
+  const auto source { compiler.compile(success, failure) };
+
+  boost::filesystem::create_directories(directory);
+
+  const auto path { (boost::filesystem::path(directory) / "end_condition.cpp").string() };
+
+  std::ofstream { path } << source;
+  std::ofstream { (boost::filesystem::path(directory) / "CMakeLists.txt").string() } << cmake_lists;
+
+  SCENARIO_INFO_STREAM(CATEGORY(),
+    "Generated compiled end condition \"" << path << "\" over " << compiler.predicates().size() << " predicates.");
+
+  return path;
+}
+
+simulation_is CompiledEndCondition::evaluate(const scenario_expression::compiled::Intersections& intersections)
+{
+  if ((failure_ = end_condition_->failure(predicates_.data(), intersections)).value)
+  {
+    return simulation_is::failed;
+  }
+  else if ((success_ = end_condition_->success(predicates_.data(), intersections)).value)
+  {
+    return simulation_is::succeeded;
+  }
+  else
+  {
+    return simulation_is::ongoing;
+  }
+}
+
+void CompiledEndCondition::verify(
+  const scenario_expression::compiled::Intersections& intersections,
+  const scenario_expression::Expression& success,
+  const scenario_expression::Expression& failure)
+{
+  ++ticks_;
+
+  // NOTE: After the interpreter, whose plugins have been updated in this tick (see replayed).
+  evaluate(intersections);
+
+  if (not same(failure_, failure) or (not failure_.value and not same(success_, success)))
+  {
+    if (not mismatches_++)
+    {
+      first_mismatch_ = (scenario_logger::now() - scenario_logger::log.begin()).toSec();
+    }
+
+    SCENARIO_ERROR_STREAM(CATEGORY(),
+      "Compiled end condition disagrees with the interpreter: failure " <<
+      std::boolalpha << failure_.value << " (" << failure_.robustness << ") instead of " <<
+      static_cast<bool>(failure) << " (" << failure.robustness() << "), success " <<
+      success_.value << " (" << success_.robustness << ") instead of " <<
+      static_cast<bool>(success) << " (" << success.robustness() << ").");
+  }
+}
+
+boost::property_tree::ptree CompiledEndCondition::toJson() const
+{
+  boost::property_tree::ptree tree {};
+
+  tree.put("path", path_);
+  tree.put("predicates", predicates_.size());
+  tree.put("verified", verify_);
+
+  if (verify_)
+  {
+    tree.put("ticks", ticks_);
+    tree.put("mismatches", mismatches_);
+
+    if (mismatches_)
+    {
+      tree.put("first_mismatch", first_mismatch_);
+    }
+  }
+
+  return tree;
+}
+
+}  // namespace scenario_runner
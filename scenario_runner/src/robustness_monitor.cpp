@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <limits>
+
+#include <scenario_runner/robustness_monitor.h>
+
+namespace scenario_runner
+{
+
+RobustnessMonitor::RobustnessMonitor()
+  : ticks_ {0}
+{}
+
+void RobustnessMonitor::update(double success, double failure)
+{
+  ++ticks_;
+  success_.update(success);
+  failure_.update(failure);
+}
+
+boost::property_tree::ptree RobustnessMonitor::toJson() const
+{
+  boost::property_tree::ptree tree {};
+
+  tree.put("ticks", ticks_);
+
+  if (0 < ticks_)
+  {
+    tree.add_child("success", success_.toJson());
+    tree.add_child("failure", failure_.toJson());
+  }
+
+  return tree;
+}
+
+RobustnessMonitor::Extremes::Extremes()
+  : minimum { std::numeric_limits<double>::infinity()}
+  , maximum {-std::numeric_limits<double>::infinity()}
+  , last {std::numeric_limits<double>::quiet_NaN()}
+{}
+
+void RobustnessMonitor::Extremes::update(double robustness)
+{
+  minimum = std::min(minimum, robustness);
+  maximum = std::max(maximum, robustness);
+  last = robustness;
+}
+
+boost::property_tree::ptree RobustnessMonitor::Extremes::toJson() const
+{
+  boost::property_tree::ptree tree {};
+
+  tree.put("minimum", minimum);
+  tree.put("maximum", maximum);
+  tree.put("final", last);
+
+  return tree;
+}
+
+}  // namespace scenario_runner
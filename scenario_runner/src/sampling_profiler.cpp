@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <sched.h>
+#include <ucontext.h>
+
+#define UNW_LOCAL_ONLY
+#include <libunwind.h>
+
+#include <scenario_logger/logger.h>
+#include <scenario_runner/sampling_profiler.h>
+
+namespace scenario_runner
+{
+
+std::atomic<SamplingProfiler*> SamplingProfiler::active_ { nullptr };
+
+std::atomic<int> SamplingProfiler::handling_ { 0 };
+
+namespace
+{
+
+/* NOTE: libunwind rather than backtrace, which is not async-signal-safe (the
+ * unwinder of libgcc may take its locks, e.g. while the interrupted thread
+ * throws). Includes the frames of the handler and the signal trampoline. */
+int unwind(void** frames, int max_depth) noexcept
+{
+  unw_context_t context {};
+  unw_cursor_t cursor {};
+
+  if (::unw_getcontext(&context) != 0 or ::unw_init_local(&cursor, &context) != 0)
+  {
+    return 0;
+  }
+
+  int depth {0};
+
+  do
+  {
+    unw_word_t ip {0};
+
+    if (::unw_get_reg(&cursor, UNW_REG_IP, &ip) != 0 or ip == 0)
+    {
+      break;
+    }
+
+    frames[depth++] = reinterpret_cast<void*>(ip);
+  }
+  while (depth < max_depth and 0 < ::unw_step(&cursor));
+
+  return depth;
+}
+
+std::string symbolize(void* address)
+{
+  Dl_info info {};
+
+  if (::dladdr(address, &info) == 0)
+  {
+    std::stringstream ss {};
+    ss << address;
+    return ss.str();
+  }
+
+  if (info.dli_sname)
+  {
+    int status {0};
+
+    std::unique_ptr<char, decltype(&std::free)> demangled {
+      abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), &std::free
+    };
+
+    return status == 0 ? demangled.get() : info.dli_sname;
+  }
+  else
+  {
+    // NOTE: Not exported; module and offset are still enough for addr2line.
+    std::stringstream ss {};
+    ss << (info.dli_fname ? info.dli_fname : "?") << "+0x" << std::hex
+       << (static_cast<char*>(address) - static_cast<char*>(info.dli_fbase));
+    return ss.str();
+  }
+}
+
+}  // namespace
+
+SamplingProfiler::SamplingProfiler(std::size_t capacity)
+  : capacity_ {capacity}
+  , size_ {0}
+  , dropped_ {0}
+  , running_ {false}
+  , timer_ {}
+  , previous_action_ {}
+{}
+
+SamplingProfiler::~SamplingProfiler()
+{
+  stop();
+}
+
+bool SamplingProfiler::start(double frequency, const std::string& output_path)
+{
+  if (running_ or not (0 < frequency))
+  {
+    return false;
+  }
+
+  output_path_ = output_path;
+
+  // NOTE: Allocated only once enabled, as the buffer is large (capacity x max_depth frames).
+  if (not frames_)
+  {
+    frames_.reset(new void*[capacity_ * max_depth]);
+    depths_.reset(new unsigned char[capacity_]);
+  }
+
+  size_ = 0;
+  dropped_ = 0;
+
+  // NOTE: Per thread, so that unwinding in signal context takes no lock. The
+  // first unwinding initializes libunwind, which is not async-signal-safe.
+  ::unw_set_caching_policy(::unw_local_addr_space, UNW_CACHE_PER_THREAD);
+
+  void* warmup[max_depth];
+  unwind(warmup, max_depth);
+
+  active_.store(this);
+
+  struct sigaction action {};
+  action.sa_sigaction = &SamplingProfiler::handle;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+
+  if (::sigaction(SIGPROF, &action, &previous_action_) != 0)
+  {
+    active_.store(nullptr);
+    return false;
+  }
+
+  struct sigevent event {};
+  event.sigev_notify = SIGEV_SIGNAL;
+  event.sigev_signo = SIGPROF;
+
+  if (::timer_create(CLOCK_PROCESS_CPUTIME_ID, &event, &timer_) != 0)
+  {
+    ::sigaction(SIGPROF, &previous_action_, nullptr);
+    active_.store(nullptr);
+    return false;
+  }
+
+  const auto period { static_cast<long>(1e9 / frequency) };
+
+  struct itimerspec spec {};
+  spec.it_interval.tv_sec = period / 1000000000;
+  spec.it_interval.tv_nsec = period % 1000000000;
+  spec.it_value = spec.it_interval;
+
+  if (::timer_settime(timer_, 0, &spec, nullptr) != 0)
+  {
+    ::timer_delete(timer_);
+    ::sigaction(SIGPROF, &previous_action_, nullptr);
+    active_.store(nullptr);
+    return false;
+  }
+
+  SCENARIO_INFO_STREAM(CATEGORY(),
+    "Sampling profiler started at " << frequency << " Hz (output: " << output_path_ << ").");
+
+  return running_ = true;
+}
+
+void SamplingProfiler::stop()
+{
+  if (running_)
+  {
+    active_.store(nullptr);
+
+    // NOTE: Ignored first, which also discards a pending SIGPROF; restoring the
+    // previous action (SIG_DFL, which terminates) would let it kill the process.
+    struct sigaction ignore {};
+    ignore.sa_handler = SIG_IGN;
+    sigemptyset(&ignore.sa_mask);
+    ::sigaction(SIGPROF, &ignore, nullptr);
+
+    ::timer_delete(timer_);
+
+    // NOTE: Handlers already running on other threads may still be recording.
+    while (handling_.load())
+    {
+      ::sched_yield();
+    }
+
+    ::sigaction(SIGPROF, &previous_action_, nullptr);
+
+    running_ = false;
+
+    write();
+  }
+}
+
+void SamplingProfiler::handle(int, siginfo_t*, void* context)
+{
+  const auto saved_errno { errno };
+
+  ++handling_;
+
+  void* pc { nullptr };
+
+#if defined(__x86_64__)
+  pc = reinterpret_cast<void*>(static_cast<ucontext_t*>(context)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+  pc = reinterpret_cast<void*>(static_cast<ucontext_t*>(context)->uc_mcontext.pc);
+#endif
+
+  if (auto* const profiler { active_.load() })
+  {
+    profiler->record(pc);
+  }
+
+  --handling_;
+
+  errno = saved_errno;
+}
+
+void SamplingProfiler::record(void* pc) noexcept
+{
+  const auto index { size_.fetch_add(1, std::memory_order_relaxed) };
+
+  if (index < capacity_)
+  {
+    void** const frames { &frames_[index * max_depth] };
+
+    int depth { unwind(frames, max_depth) };
+
+    // NOTE: Drop the frames of the handler and the signal trampoline.
+    for (int skip {0}; skip < depth; ++skip)
+    {
+      if (frames[skip] == pc)
+      {
+        std::copy(frames + skip, frames + depth, frames);
+        depth -= skip;
+        break;
+      }
+    }
+
+    depths_[index] = static_cast<unsigned char>(depth);
+  }
+  else
+  {
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool SamplingProfiler::write() const
+{
+  if (output_path_.empty() or not frames_)
+  {
+    return false;
+  }
+
+  const auto size { std::min(size_.load(), capacity_) };
+
+  std::map<void*, std::string> symbols {};
+  std::map<std::string, std::size_t> folded {};
+
+  for (std::size_t index {0}; index < size; ++index)
+  {
+    void* const* const frames { &frames_[index * max_depth] };
+
+    std::string stack {};
+
+    for (int depth { depths_[index] - 1 }; 0 <= depth; --depth)
+    {
+      auto iter { symbols.find(frames[depth]) };
+
+      if (iter == symbols.end())
+      {
+        // NOTE: Except for the leaf, addresses are return addresses (just after the call).
+        iter = symbols.emplace(
+          frames[depth], symbolize(static_cast<char*>(frames[depth]) - (depth ? 1 : 0))).first;
+      }
+
+      if (not stack.empty())
+      {
+        stack += ';';
+      }
+
+      stack += iter->second;
+    }
+
+    ++folded[stack];
+  }
+
+  std::ofstream ofs { output_path_ };
+
+  for (const auto& each : folded)
+  {
+    ofs << each.first << ' ' << each.second << '\n';
+  }
+
+  SCENARIO_INFO_STREAM(CATEGORY(),
+    "Sampling profiler wrote " << size << " samples (" << dropped_.load() << " dropped) to " << output_path_ << ".");
+
+  return static_cast<bool>(ofs);
+}
+
+}  // namespace scenario_runner
@@ -1,3 +1,10 @@
+#include <algorithm>
+#include <limits>
+
+#include <boost/filesystem.hpp>
+
+#include <scenario_api_utils/scenario_api_utils.h>
+#include <scenario_expression/optimizer.h>
 #include <scenario_logger/logger.h>
 #include <scenario_runner/scenario_runner.h>
 
@@ -10,6 +17,51 @@ ScenarioRunner::ScenarioRunner(ros::NodeHandle nh, ros::NodeHandle pnh)
   simulator_{std::make_shared<ScenarioAPI>()}
 {
   pnh_.getParam("scenario_path", scenario_path_);
+  pnh_.param<bool>("perf_counters", use_perf_counters_, false);
+  pnh_.param<bool>("dispatch_latency", use_dispatch_latency_, false);
+  pnh_.param<bool>("record_time_series", record_time_series_, false);
+  pnh_.param<bool>("optimize_conditions", optimize_conditions_, true);
+  pnh_.param<bool>("short_circuit_conditions", short_circuit_conditions_, false);
+  pnh_.param<std::string>("compile_end_condition", compile_end_condition_, "");
+  pnh_.param<std::string>("compiled_end_condition", compiled_end_condition_, "");
+  pnh_.param<bool>("verify_compiled_end_condition", verify_compiled_end_condition_, false);
+
+  bool robustness_monitor {false};
+  pnh_.param<bool>("robustness_monitor", robustness_monitor, false);
+  if (robustness_monitor)
+  {
+    robustness_monitor_ = std::make_shared<RobustnessMonitor>();
+  }
+
+  double tick_budget;
+  pnh_.param<double>("tick_budget", tick_budget, 0.0);
+  if (0 < tick_budget)
+  {
+    std::vector<std::string> tick_load_shedding {};
+    pnh_.param<std::vector<std::string>>(
+      "tick_load_shedding", tick_load_shedding, { "low_priority", "telemetry" });
+    int tick_recovery, tick_max_deferral;
+    pnh_.param<int>("tick_recovery", tick_recovery, 10);
+    pnh_.param<int>("tick_max_deferral", tick_max_deferral, 10);
+    tick_watchdog_ = std::make_shared<scenario_logger::TickWatchdog>(
+      tick_budget, scenario_logger::TickWatchdog::parse(tick_load_shedding),
+      std::max(tick_recovery, 1), std::max(tick_max_deferral, 0));
+  }
+
+  double log_flood_window;
+  int log_flood_burst, log_flood_repeat;
+  pnh_.param<double>("log_flood_window", log_flood_window, 1.0);
+  pnh_.param<int>("log_flood_burst", log_flood_burst, 20);
+  pnh_.param<int>("log_flood_repeat", log_flood_repeat, 3);
+  scenario_logger::log.configureFloodControl(
+    log_flood_window, std::max(log_flood_burst, 1), std::max(log_flood_repeat, 1));
+
+  double time_monitor_window, clock_stall_threshold, tick_starvation_threshold;
+  pnh_.param<double>("time_monitor_window", time_monitor_window, 1.0);
+  pnh_.param<double>("clock_stall_threshold", clock_stall_threshold, 0.5);
+  pnh_.param<double>("tick_starvation_threshold", tick_starvation_threshold, 0.1);
+  time_monitor_ = std::make_shared<TimeMonitor>(
+    time_monitor_window, clock_stall_threshold, tick_starvation_threshold);
 
   if (not (*simulator_).waitAutowareInitialize())
   {
@@ -30,6 +82,48 @@ void ScenarioRunner::run()
 try
 {
   context.define(simulator_);
+  context.define(std::make_shared<scenario_conditions::ConditionGroups>());
+  context.define(std::make_shared<scenario_actions::TimerWheel>());
+  context.define(std::make_shared<scenario_actions::EntityIndex>());
+
+  if (optimize_conditions_)
+  {
+    // NOTE: Short-circuiting would leave the robustness of the end conditions partial.
+    context.define(std::make_shared<scenario_expression::Optimizer>(
+      short_circuit_conditions_ and
+      not robustness_monitor_ and compile_end_condition_.empty() and compiled_end_condition_.empty()));
+  }
+
+  if (tick_watchdog_)
+  {
+    context.define(tick_watchdog_);
+
+    scenario_logger::log.setMetadataProvider("tick_watchdog", [watchdog = tick_watchdog_]()
+    {
+      return watchdog->toJson();
+    });
+  }
+
+  if (use_perf_counters_)
+  {
+    context.define(perf_counters_ = std::make_shared<scenario_logger::PerfCounters>());
+
+    // NOTE: Captured by value, so that the log outlives this runner safely.
+    scenario_logger::log.setMetadataProvider("perf_counters", [counters = perf_counters_]()
+    {
+      return counters->toJson();
+    });
+  }
+
+  if (use_dispatch_latency_)
+  {
+    context.define(dispatch_latency_ = std::make_shared<scenario_logger::DispatchLatency>());
+
+    scenario_logger::log.setMetadataProvider("dispatch_latency", [latency = dispatch_latency_]()
+    {
+      return latency->toJson();
+    });
+  }
 
   call_with_essential(scenario_, "Entity", [&](const auto& node) mutable
   {
@@ -75,31 +169,82 @@ try
     {
       call_with_optional(node, "Success", [&](const auto& node) mutable
       {
-        success = scenario_expression::read(context, node);
+        success = scenario_expression::optimize(context, scenario_expression::read(context, node));
         SCENARIO_INFO_STREAM(CATEGORY(), "Loaded success condition: " << success);
       });
 
       call_with_optional(node, "Failure", [&](const auto& node) mutable
       {
-        failure = scenario_expression::read(context, node);
+        failure = scenario_expression::optimize(context, scenario_expression::read(context, node));
         SCENARIO_INFO_STREAM(CATEGORY(), "Loaded failure condition: " << failure);
       });
     });
   });
 
+  if (not compile_end_condition_.empty())
+  {
+    CompiledEndCondition::generate(compile_end_condition_, success, failure);
+  }
+
+  if (not compiled_end_condition_.empty())
+  {
+    try
+    {
+      end_condition_ = std::make_shared<CompiledEndCondition>(
+        compiled_end_condition_, success, failure, verify_compiled_end_condition_);
+
+      scenario_logger::log.setMetadataProvider("compiled_end_condition", [end_condition = end_condition_]()
+      {
+        return end_condition->toJson();
+      });
+    }
+    catch (...)
+    {
+      // NOTE: The reason has been logged already.
+      SCENARIO_WARN_STREAM(CATEGORY(), "Interpreting the end conditions instead.");
+    }
+  }
+
   SCENARIO_INFO_STREAM(CATEGORY(), "Waiting for the simulator API to be ready.");
   simulator_->waitAPIReady();
   SCENARIO_INFO_STREAM(CATEGORY(), "Simulator API is ready.");
 
-  timer_ = nh_.createTimer(ros::Duration(0.01), &ScenarioRunner::update, this);
-
   if (not simulator_->sendEngage(true))
   {
     SCENARIO_ERROR_THROW(CATEGORY(), "Failed to send engage.");
   }
   SCENARIO_INFO_STREAM(CATEGORY("simulation", "progress"), "ScenarioRunner engaged Autoware.");
 
-  scenario_logger::log.initialize(ros::Time::now()); // NOTE: initialize logger's clock here.
+  scenario_logger::log.initialize(scenario_logger::now()); // NOTE: initialize logger's clock here.
+
+  scenario_logger::log.setMetadataProvider("time_monitor", [monitor = time_monitor_]()
+  {
+    return monitor->toJson();
+  });
+
+  if (robustness_monitor_)
+  {
+    scenario_logger::log.setMetadataProvider("robustness", [monitor = robustness_monitor_]()
+    {
+      return monitor->toJson();
+    });
+  }
+
+  std::string log_output_path {};
+  pnh_.param<std::string>("log_output_path", log_output_path, "");
+
+  if (record_time_series_ and not log_output_path.empty())
+  {
+    time_series_ = std::make_shared<scenario_logger::TimeSeriesWriter>(
+      boost::filesystem::path(log_output_path).replace_extension(".series").string(),
+      std::vector<std::string> {
+        "time", "entity", "x", "y", "yaw", "speed", "acceleration", "lane", "lane_change"
+      });
+  }
+
+  // NOTE: Created last, as engaging spins the callback queue while it waits for the ego.
+  timer_ = nh_.createTimer(ros::Duration(0.01), &ScenarioRunner::update, this);
+
   SCENARIO_INFO_STREAM(CATEGORY("simulation", "progress"), "Simulation started.");
 }
 catch (...)
@@ -107,24 +252,105 @@ catch (...)
   SCENARIO_ERROR_RETHROW(CATEGORY(), "Failed to initialize ScenarioRunner.");
 }
 
+scenario_logger::PerfCounters::Scope ScenarioRunner::measure(const std::string& phase)
+{
+  return perf_counters_ ? perf_counters_->measure(phase) : scenario_logger::PerfCounters::Scope();
+}
+
 void ScenarioRunner::update(const ros::TimerEvent & event) try
 {
-  scenario_logger::log.updateMoveDistance(simulator_->getMoveDistance());
-  (*sequence_manager_).update(intersection_manager_);
+  // NOTE: Everything in this tick sees the same time.
+  const scenario_logger::Clock::Tick latch { scenario_logger::clock() };
 
-  // currently = (*entity_manager_).update(intersection_manager_);
+  time_monitor_->update(scenario_logger::now(), (event.current_real - event.current_expected).toSec());
+
+  if (tick_watchdog_)
+  {
+    tick_watchdog_->begin();
+  }
+
+  if (dispatch_latency_)
+  {
+    dispatch_latency_->tick((event.current_real - event.current_expected).toSec());
+  }
+
+  const auto tick { measure("phase/tick") };
+
+  {
+    const auto phase { measure("phase/entities") };
+    scenario_logger::log.updateMoveDistance(simulator_->getMoveDistance());
+    simulator_->updateEntityStates();
+    context.entity_index().build(simulator_->getEntityStates());
+
+    if (time_series_)
+    {
+      record();
+    }
+  }
+
+  {
+    const auto phase { measure("phase/conditions") };
+    context.condition_groups().update(
+      scenario_conditions::Snapshot { simulator_->getEntityStates(), intersection_manager_ });
+  }
 
-  if (failure.evaluate(context))
   {
-    currently = simulation_is::failed;
+    // NOTE: Actions scheduled with Delay or Period that are due by now.
+    const auto phase { measure("phase/timers") };
+    context.timer_wheel().advance((scenario_logger::now() - scenario_logger::log.begin()).toSec());
   }
-  else if (success.evaluate(context))
+
   {
-    currently = simulation_is::succeeded;
+    const auto phase { measure("phase/sequence") };
+    (*sequence_manager_).update(intersection_manager_);
+  }
+
+  // currently = (*entity_manager_).update(intersection_manager_);
+
+  const auto phase { measure("phase/end_condition") };
+
+  if (end_condition_ and not end_condition_->verifies())
+  {
+    currently = end_condition_->evaluate(intersection_manager_);
   }
   else
   {
-    currently = simulation_is::ongoing;
+    if (failure.evaluate(context))
+    {
+      currently = simulation_is::failed;
+    }
+    else if (success.evaluate(context))
+    {
+      currently = simulation_is::succeeded;
+    }
+    else
+    {
+      currently = simulation_is::ongoing;
+    }
+
+    if (end_condition_)
+    {
+      end_condition_->verify(intersection_manager_, success, failure);
+    }
+  }
+
+  if (robustness_monitor_)
+  {
+    // NOTE: Success is not evaluated in the tick failure holds; its last value is used then.
+    if (end_condition_ and not end_condition_->verifies())
+    {
+      robustness_monitor_->update(end_condition_->successRobustness(), end_condition_->failureRobustness());
+    }
+    else
+    {
+      robustness_monitor_->update(success.robustness(), failure.robustness());
+    }
+  }
+
+  if (tick_watchdog_)
+  {
+    // NOTE: Decides whether the following ticks shed load.
+    tick_watchdog_->end((scenario_logger::now() - scenario_logger::log.begin()).toSec());
   }
 }
 catch (...)
@@ -132,4 +358,44 @@ catch (...)
   SCENARIO_ERROR_RETHROW(CATEGORY(), "Failed to update simulation.");
 }
 
+void ScenarioRunner::record()
+{
+  const double time { (scenario_logger::now() - scenario_logger::log.begin()).toSec() };
+
+  for (const auto& each : simulator_->getEntityStates())
+  {
+    int lane { -1 };
+    simulator_->getEntityLaneID(each.name, lane);
+
+    const auto previous { recorded_.find(each.name) };
+
+    // NOTE: Finite difference; NaN on the first row of each entity.
+    const double acceleration {
+      previous != recorded_.end() and previous->second.time < time
+        ? (each.twist.linear.x - previous->second.speed) / (time - previous->second.time)
+        : std::numeric_limits<double>::quiet_NaN()
+    };
+
+    const double lane_change {
+      previous != recorded_.end() and previous->second.lane != lane ? 1.0 : 0.0
+    };
+
+    const double row[] {
+      time,
+      time_series_->intern(each.name),
+      each.pose.position.x,
+      each.pose.position.y,
+      yawFromQuat(each.pose.orientation),
+      each.twist.linear.x,
+      acceleration,
+      static_cast<double>(lane),
+      lane_change,
+    };
+
+    time_series_->append(row);
+
+    recorded_[each.name] = Recorded { time, each.twist.linear.x, lane };
+  }
+}
+
 }  // namespace scenario_runner
@@ -3,17 +3,23 @@
 #include <exception>
 #include <glog/logging.h>
 #include <ros/ros.h>
+#include <boost/filesystem.hpp>
 #include <scenario_logger/logger.h>
+#include <scenario_runner/sampling_profiler.h>
 #include <scenario_runner/scenario_runner.h>
 #include <scenario_runner/scenario_terminater.h>
 
 
 static scenario_runner::ScenarioTerminator terminator { "0.0.0.0", 10000 };
 
+// NOTE: Stopped (which writes the folded stacks) wherever the log is written.
+static scenario_runner::SamplingProfiler profiler {};
+
 static void failureCallback()
 {
   SCENARIO_ERROR_STREAM(CATEGORY("simulator", "endcondition"), "Simulation failed unexpectedly.");
   scenario_logger::log.write();
+  profiler.stop();
 }
 
 int main(int argc, char * argv[]) try
@@ -36,6 +42,15 @@ int main(int argc, char * argv[]) try
   pnh.getParam("log_output_path", log_output_path);
   scenario_logger::log.setLogOutputPath(log_output_path);
 
+  double profiler_frequency { 0 }; // NOTE: [Hz]. Disabled by default.
+  pnh.param<double>("profiler_frequency", profiler_frequency, 0);
+  if (0 < profiler_frequency and not log_output_path.empty())
+  {
+    profiler.start(
+      profiler_frequency,
+      boost::filesystem::path(log_output_path).replace_extension(".folded").string());
+  }
+
   SCENARIO_INFO_STREAM(CATEGORY(), "Sleep for 10 seconds.");
   std::this_thread::sleep_for(std::chrono::seconds { 10 });
   SCENARIO_INFO_STREAM(CATEGORY(), "Wake-up.");
@@ -60,12 +75,14 @@ int main(int argc, char * argv[]) try
       case simulation_is::succeeded:
         SCENARIO_INFO_STREAM(CATEGORY("simulator", "endcondition"), "simulation succeeded");
         scenario_logger::log.write();
+        profiler.stop();
         terminator.sendTerminateRequest(boost::exit_success);
         return boost::exit_success;
 
       case simulation_is::failed:
         SCENARIO_INFO_STREAM(CATEGORY("simulator", "endcondition"), "simulation failed");
         scenario_logger::log.write();
+        profiler.stop();
         terminator.sendTerminateRequest(boost::exit_test_failure);
         return boost::exit_test_failure;
 
@@ -74,16 +91,20 @@ int main(int argc, char * argv[]) try
       }
     }
 
-    terminator.update_mileage(runner.current_mileage());
+    if (runner.report())
+    {
+      terminator.update_mileage(runner.current_mileage());
 
-    terminator.update_duration(
-      (ros::Time::now() - scenario_logger::log.begin()).toSec());
+      terminator.update_duration(
+        (ros::Time::now() - scenario_logger::log.begin()).toSec());
+    }
   }
 
   if (runner.currently == simulation_is::ongoing)
   {
     SCENARIO_INFO_STREAM(CATEGORY(), "Simulation aborted.");
     scenario_logger::log.write();
+    profiler.stop();
     terminator.sendTerminateRequest(boost::exit_failure);
     return boost::exit_failure;
   }
@@ -91,6 +112,7 @@ int main(int argc, char * argv[]) try
   {
     SCENARIO_INFO_STREAM(CATEGORY(), "Simulation unexpectedly failed.");
     scenario_logger::log.write();
+    profiler.stop();
     return boost::exit_exception_failure;
   }
 }
@@ -99,6 +121,7 @@ catch (const std::exception& e)
 {
   SCENARIO_ERROR_STREAM(CATEGORY("simulator", "endcondition"), "Unexpected standard exception thrown: " << e.what());
   scenario_logger::log.write();
+  profiler.stop();
   terminator.sendTerminateRequest(boost::exit_exception_failure);
 }
 
@@ -106,5 +129,6 @@ catch (...)
 {
   SCENARIO_ERROR_STREAM(CATEGORY("simulator", "endcondition"), "Unexpected non-standard exception thrown.");
   scenario_logger::log.write();
+  profiler.stop();
   terminator.sendTerminateRequest(boost::exit_exception_failure);
 }
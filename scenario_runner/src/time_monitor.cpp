@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <limits>
+
+#include <scenario_logger/logger.h>
+#include <scenario_runner/time_monitor.h>
+
+namespace scenario_runner
+{
+
+namespace
+{
+
+double seconds(TimeMonitor::wall_clock::duration duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+
+}  // namespace
+
+TimeMonitor::TimeMonitor(double window, double stall_threshold, double starvation_threshold)
+  : window_ {window}
+  , stall_threshold_ {stall_threshold}
+  , starvation_threshold_ {starvation_threshold}
+  , started_ {false}
+  , sim_time_before_ {0}
+  , ticks_ {0}
+  , stalled_ {false}
+  , stalls_ {0}
+  , stalled_time_ {0}
+  , longest_stall_ {0}
+  , backward_jumps_ {0}
+  , largest_backward_jump_ {0}
+  , starved_ticks_ {0}
+  , longest_tick_interval_ {0}
+  , longest_lag_ {0}
+  , real_time_factor_ {1}
+  , min_real_time_factor_ {std::numeric_limits<double>::infinity()}
+  , max_real_time_factor_ {0}
+{}
+
+void TimeMonitor::update(const ros::Time& sim, double lag, wall_clock::time_point wall)
+{
+  ++ticks_;
+
+  if (not started_)
+  {
+    started_ = true;
+    first_sim_ = last_sim_ = window_sim_ = last_advance_sim_ = sim;
+    first_wall_ = last_wall_ = window_wall_ = last_advance_wall_ = wall;
+    return;
+  }
+
+  /* ---- starvation ------------------------------------------------------- */
+  longest_tick_interval_ = std::max(longest_tick_interval_, seconds(wall - last_wall_));
+
+  // NOTE: Unknown while the simulation clock stands still, which is a stall rather than starvation.
+  if (0 < real_time_factor_)
+  {
+    const auto wall_lag { lag / real_time_factor_ };
+
+    longest_lag_ = std::max(longest_lag_, wall_lag);
+
+    if (starvation_threshold_ < wall_lag)
+    {
+      ++starved_ticks_;
+    }
+  }
+
+  /* ---- backward jump ---------------------------------------------------- */
+  if (sim < last_sim_)
+  {
+    const auto jump { (last_sim_ - sim).toSec() };
+
+    ++backward_jumps_;
+    largest_backward_jump_ = std::max(largest_backward_jump_, jump);
+
+    SCENARIO_WARN_STREAM(CATEGORY("simulation", "clock"),
+      "Simulation time jumped back by " << jump << " [s].");
+
+    // NOTE: Restart the windows and the elapsed time from here, as the times before are meaningless now.
+    sim_time_before_ += (last_sim_ - first_sim_).toSec();
+    first_sim_ = window_sim_ = last_advance_sim_ = sim;
+    window_wall_ = last_advance_wall_ = wall;
+  }
+
+  /* ---- stall ------------------------------------------------------------ */
+  if (last_advance_sim_ < sim)
+  {
+    if (stalled_)
+    {
+      const auto stall { seconds(wall - last_advance_wall_) };
+
+      stalled_ = false;
+      stalled_time_ += stall;
+      longest_stall_ = std::max(longest_stall_, stall);
+
+      SCENARIO_WARN_STREAM(CATEGORY("simulation", "clock"),
+        "Simulation clock resumed after stalling for " << stall << " [s].");
+    }
+
+    last_advance_sim_ = sim;
+    last_advance_wall_ = wall;
+  }
+  else if (not stalled_ and stall_threshold_ < seconds(wall - last_advance_wall_))
+  {
+    stalled_ = true;
+    ++stalls_;
+
+    SCENARIO_WARN_STREAM(CATEGORY("simulation", "clock"),
+      "Simulation clock stalled at " << sim.toSec() << " [s].");
+  }
+
+  /* ---- real-time factor ------------------------------------------------- */
+  const auto window_wall_time { seconds(wall - window_wall_) };
+
+  if (window_ <= window_wall_time)
+  {
+    real_time_factor_ = (sim - window_sim_).toSec() / window_wall_time;
+
+    min_real_time_factor_ = std::min(min_real_time_factor_, real_time_factor_);
+    max_real_time_factor_ = std::max(max_real_time_factor_, real_time_factor_);
+
+    samples_.push_back({
+      seconds(wall - first_wall_), sim_time_before_ + (sim - first_sim_).toSec(), real_time_factor_
+    });
+
+    window_sim_ = sim;
+    window_wall_ = wall;
+  }
+
+  last_sim_ = sim;
+  last_wall_ = wall;
+}
+
+boost::property_tree::ptree TimeMonitor::toJson() const
+{
+  boost::property_tree::ptree tree {};
+
+  const auto wall_time { seconds(last_wall_ - first_wall_) };
+  const auto sim_time { sim_time_before_ + (last_sim_ - first_sim_).toSec() };
+
+  tree.put("ticks", ticks_);
+  tree.put("wall_time", wall_time);
+  tree.put("sim_time", sim_time);
+
+  if (0 < wall_time)
+  {
+    tree.put("real_time_factor.mean", sim_time / wall_time);
+  }
+
+  if (not samples_.empty())
+  {
+    tree.put("real_time_factor.min", min_real_time_factor_);
+    tree.put("real_time_factor.max", max_real_time_factor_);
+  }
+
+  tree.put("stall.count", stalls_);
+  tree.put("stall.total_time", stalled_time_ + (stalled_ ? seconds(last_wall_ - last_advance_wall_) : 0.0));
+  tree.put("stall.longest", std::max(longest_stall_, stalled_ ? seconds(last_wall_ - last_advance_wall_) : 0.0));
+  tree.put("stall.ongoing", stalled_);
+
+  tree.put("backward_jump.count", backward_jumps_);
+  tree.put("backward_jump.largest", largest_backward_jump_);
+
+  tree.put("starvation.count", starved_ticks_);
+  tree.put("starvation.longest_lag", longest_lag_);
+  tree.put("starvation.longest_tick_interval", longest_tick_interval_);
+
+  boost::property_tree::ptree series {};
+
+  for (const auto& each : samples_)
+  {
+    boost::property_tree::ptree sample {};
+
+    sample.put("wall_time", each.wall_time);
+    sample.put("sim_time", each.sim_time);
+    sample.put("real_time_factor", each.real_time_factor);
+
+    series.push_back(std::make_pair("", sample));
+  }
+
+  tree.add_child("real_time_factor.series", series);
+
+  return tree;
+}
+
+}  // namespace scenario_runner
@@ -2,8 +2,11 @@
 #define SCENARIO_UTILS_PARSE_H_INCLUDED
 
 #include <boost/optional.hpp>
+#include <cmath>
+#include <cstdint>
 #include <geometry_msgs/PointStamped.h>
 #include <geometry_msgs/PoseStamped.h>
+#include <limits>
 #include <ros/ros.h>
 #include <scenario_logger/logger.h>
 #include <sstream>
@@ -29,6 +32,11 @@ READ_AS_SPECIALIZED_SIGNATURE(geometry_msgs::Quaternion);
 READ_AS_SPECIALIZED_SIGNATURE(geometry_msgs::Pose);
 READ_AS_SPECIALIZED_SIGNATURE(geometry_msgs::PoseStamped);
 
+/* NOTE: Every parser warns from the lines below, so each clause is a call site
+ * of its own for the flood control (see scenario_logger::FloodControl). */
+#define SCENARIO_PARSE_FROM(KEY) \
+  SCENARIO_LOG_FROM + " (" + KEY + ")"
+
 template <typename T>
 T read_essential(const YAML::Node& node, const std::string& key)
 {
@@ -79,7 +87,7 @@ T read_optional(
   }
   else
   {
-    SCENARIO_WARN_STREAM(CATEGORY(),
+    SCENARIO_WARN_STREAM_FROM(CATEGORY(), SCENARIO_PARSE_FROM(key),
       "syntax-warning: missing optional clause " << key << ". Use default value " << value << "\n\n" << node << "\n");
     return value;
   }
@@ -108,7 +116,7 @@ T read_optional(const YAML::Node& node, const std::string& key, F&& f)
   }
   else
   {
-    SCENARIO_WARN_STREAM(CATEGORY(),
+    SCENARIO_WARN_STREAM_FROM(CATEGORY(), SCENARIO_PARSE_FROM(key),
       "syntax-warning: missing optional clause " << key << ". Use default value.\n\n" << node << "\n");
     return f();
   }
@@ -139,7 +147,7 @@ void call_with_optional(
   }
   else
   {
-    SCENARIO_WARN_STREAM(CATEGORY(),
+    SCENARIO_WARN_STREAM_FROM(CATEGORY(), SCENARIO_PARSE_FROM(key),
       "syntax-warning: missing optional clause " << key << ".\n\n" << node << "\n");
   }
 }
@@ -164,6 +172,98 @@ bool parseRule(std::string rule_string, std::function<bool(const T &, const T &)
   }
   return true;
 }
+
+/* -----------------------------------------------------------------------------
+ *
+ * RULE
+ *
+ * The rule as data rather than as a std::function, so that many values can be
+ * compared against many thresholds with neither an indirect call nor a branch
+ * per comparison. Each enumerator is the set of accepted outcomes. As with the
+ * std::function comparisons, NaN is unordered: only not_equal accepts it.
+ *
+ * -------------------------------------------------------------------------- */
+enum class Rule : std::uint8_t
+{
+  less = 1,  // NOTE: outcome bits: 1 = less, 2 = equal, 4 = greater, 8 = unordered
+  equal = 2,
+  less_equal = 3,
+  greater = 4,
+  not_equal = 13,
+  greater_equal = 6,
+};
+
+inline bool parseRule(const std::string & rule_string, Rule & rule)
+{
+  if (rule_string == "Equal" or rule_string == "eq" or rule_string == "==") {
+    rule = Rule::equal;
+  } else if (rule_string == "NotEqual" or rule_string == "neq" or rule_string == "!=") {
+    rule = Rule::not_equal;
+  } else if (rule_string == "GreaterThan" or rule_string == "gt" or rule_string == ">") {
+    rule = Rule::greater;
+  } else if (rule_string == "GreaterEqual" or rule_string == "ge" or rule_string == ">=") {
+    rule = Rule::greater_equal;
+  } else if (rule_string == "LessThan" or rule_string == "lt" or rule_string == "<") {
+    rule = Rule::less;
+  } else if (rule_string == "LessEqual" or rule_string == "le" or rule_string == "<=") {
+    rule = Rule::less_equal;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+inline bool compare(const Rule rule, const T & lhs, const T & rhs) noexcept
+{
+  const unsigned ordered = (lhs < rhs) | ((lhs == rhs) << 1) | ((rhs < lhs) << 2);
+  const unsigned outcome = ordered | ((ordered == 0) << 3);
+  return (static_cast<unsigned>(rule) & outcome) != 0;
+}
+
+/* -----------------------------------------------------------------------------
+ *
+ * MARGIN
+ *
+ * Quantitative counterpart of compare (signal temporal logic robustness): how
+ * far lhs is from violating the rule if it holds (non-negative), or from
+ * satisfying it if not (negative). Equal holds only at zero margin. Strict
+ * rules (less, greater, not_equal) fail at the boundary, where the margin is
+ * the negative number closest to zero. NaN has margin infinity for not_equal,
+ * which it satisfies, and -infinity for the other rules.
+ *
+ * -------------------------------------------------------------------------- */
+inline double strict(const double margin) noexcept
+{
+  return margin == 0 ? -std::numeric_limits<double>::denorm_min() : margin;
+}
+
+inline double margin(const Rule rule, const double lhs, const double rhs) noexcept
+{
+  if (std::isnan(lhs) or std::isnan(rhs)) {
+    return (rule == Rule::not_equal ? 1 : -1) * std::numeric_limits<double>::infinity();
+  }
+  switch (rule) {
+    case Rule::less:
+      return strict(rhs - lhs);
+    case Rule::less_equal:
+      return rhs - lhs;
+    case Rule::greater:
+      return strict(lhs - rhs);
+    case Rule::greater_equal:
+      return lhs - rhs;
+    case Rule::equal:
+      return -std::abs(lhs - rhs);
+    case Rule::not_equal:
+      return strict(std::abs(lhs - rhs));
+  }
+  return -std::numeric_limits<double>::infinity();
+}
+
+inline double margin(const Rule rule, const ros::Duration & lhs, const ros::Duration & rhs) noexcept
+{
+  return margin(rule, lhs.toSec(), rhs.toSec());
+}
 }  // namespace parse
 }  // namespace scenario_utility
 
@@ -60,7 +60,7 @@ geometry_msgs::PoseStamped read_as<geometry_msgs::PoseStamped>(const YAML::Node&
   geometry_msgs::PoseStamped pose_stamped {};
 
   pose_stamped.header.frame_id = read_optional<std::string>(node, "FrameId", "/map");
-  pose_stamped.header.stamp = ros::Time::now();
+  pose_stamped.header.stamp = scenario_logger::now();
   // pose_stamped.pose = read_essential<geometry_msgs::Pose>(node, "Pose");
   pose_stamped.pose.position = read_essential<geometry_msgs::Point>(node, "Position");
   pose_stamped.pose.orientation = read_essential<geometry_msgs::Quaternion>(node, "Orientation");
@@ -0,0 +1,83 @@
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <scenario_utility/parse.h>
+
+namespace
+{
+
+const std::vector<std::string> rules { "Equal", "NotEqual", "GreaterThan", "GreaterEqual", "LessThan", "LessEqual" };
+
+constexpr float not_a_number { std::numeric_limits<float>::quiet_NaN() };
+
+// NOTE: The rule as data must agree with the std::function comparisons it replaced.
+void expectSameAsFunction(const std::string& name, float lhs, float rhs)
+{
+  Rule rule {};
+  ASSERT_TRUE(parseRule(name, rule));
+
+  std::function<bool(const float&, const float&)> function {};
+  ASSERT_TRUE(parseRule<float>(name, function));
+
+  EXPECT_EQ(compare(rule, lhs, rhs), function(lhs, rhs)) << lhs << " " << name << " " << rhs;
+
+  // NOTE: Non-negative if and only if the rule holds.
+  EXPECT_EQ(0 <= margin(rule, lhs, rhs), function(lhs, rhs)) << lhs << " " << name << " " << rhs;
+}
+
+}  // namespace
+
+TEST(Rule, AgreesWithFunctionOnNumbers)
+{
+  for (const auto& rule : rules)
+  {
+    expectSameAsFunction(rule, 1, 2);
+    expectSameAsFunction(rule, 2, 2);
+    expectSameAsFunction(rule, 3, 2);
+  }
+}
+
+TEST(Rule, AgreesWithFunctionOnNaN)
+{
+  for (const auto& rule : rules)
+  {
+    expectSameAsFunction(rule, not_a_number, 2);
+    expectSameAsFunction(rule, 2, not_a_number);
+    expectSameAsFunction(rule, not_a_number, not_a_number);
+  }
+}
+
+TEST(Rule, AcceptsNaNOnlyIfNotEqual)
+{
+  Rule rule {};
+
+  for (const auto& name : rules)
+  {
+    ASSERT_TRUE(parseRule(name, rule));
+    EXPECT_EQ(compare(rule, not_a_number, 0.0f), rule == Rule::not_equal) << name;
+    EXPECT_EQ(compare(rule, 0.0f, not_a_number), rule == Rule::not_equal) << name;
+  }
+}
+
+TEST(Rule, ComparesDurations)
+{
+  Rule rule {};
+
+  ASSERT_TRUE(parseRule("NotEqual", rule));
+  EXPECT_TRUE(compare(rule, ros::Duration(1), ros::Duration(2)));
+  EXPECT_FALSE(compare(rule, ros::Duration(2), ros::Duration(2)));
+
+  ASSERT_TRUE(parseRule("GreaterEqual", rule));
+  EXPECT_TRUE(compare(rule, ros::Duration(2), ros::Duration(2)));
+  EXPECT_FALSE(compare(rule, ros::Duration(1), ros::Duration(2)));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}